@@ -0,0 +1,574 @@
+/* Benchmark for serdes_turn_deg.
+
+  Copyright © 2023 OOTA, Masato
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  Usage: bench_serdes_turn_deg [-f text|json|csv] [-w BIT_WIDTH[,BIT_WIDTH...]] [-p PRECISION[,PRECISION...]] [-n NUM] [-t SECONDS]
+
+  It measures each public function for each bit-width, precision (if the function has it), and distribution of the input angles, and reports the time per an angle and the angles per second.
+  Build the library with the same options to compare an alternative implementation (e.g. the digit engine) with the reference implementation.
+*/
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "serdes_turn_deg.h"
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the library accepts in this build. */
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the library accepts in this build. */
+#define MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length for MAX_BIT_WIDTH and MAX_PRECISION. */
+#define BUF_SIZE SERDES_TURN_DEG_WIDE_BUF_SIZE
+/** The buffer length to serialize num angles at once with BUF_SIZE. */
+#define BATCH_BUF_SIZE(num) SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num)
+#else
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define BUF_SIZE SERDES_TURN_DEG_BUF_SIZE
+#define BATCH_BUF_SIZE(num) SERDES_TURN_DEG_BATCH_BUF_SIZE(num)
+#endif
+
+#define NUM_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+#define MAX_LIST_SIZE 64
+
+/** The default number of the input angles. */
+#define DEFAULT_NUM_OF_ANGLES (1u << 16)
+
+/** The default minimum time to measure a function. */
+#define DEFAULT_MIN_SECONDS 0.05
+
+/** The number of the centers in the clustered distribution. */
+#define NUM_OF_CLUSTERS 8
+
+
+/** The distribution of the input angles. */
+enum Distribution {
+    DIST_SEQUENTIAL,
+    DIST_UNIFORM,
+    DIST_CLUSTERED,
+    NUM_OF_DISTS
+};
+
+static const char *const dist_name[NUM_OF_DISTS] = {
+    "sequential",
+    "uniform",
+    "clustered",
+};
+
+enum OutputFormat {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_CSV
+};
+
+/** The input of the functions. */
+struct Input {
+    unsigned int bit_width;
+    int precision;
+    size_t num;
+    unsigned int *turns;
+    /** The shortest strings of turns, which are separated by NUL. */
+    char *strings;
+    /** The pointers to each string in strings. */
+    const char **string_ptrs;
+    /** The shortest strings of turns, which are separated by ','. */
+    char *joined_strings;
+    size_t joined_len;
+    double *degs;
+    /** The work buffer for the functions. */
+    char *buf;
+};
+
+/** A function to measure.
+    \return A value depending on the results to prevent the compiler from removing the calls.
+*/
+typedef unsigned long (*BenchFunc)(const struct Input *input);
+
+struct Bench {
+    const char *name;
+    BenchFunc func;
+    /** Nonzero if the function takes a precision. */
+    int uses_precision;
+};
+
+
+static unsigned long long random_state = 88172645463325252ull;
+
+/** xorshift64 to make the result reproducible in any environment. */
+static unsigned long long next_random(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+
+static unsigned long bench_serialize(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg(input->buf, input->turns[i], input->bit_width) - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_p(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg_p(input->buf, input->turns[i], input->bit_width, input->precision) - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_ps(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg_ps(input->buf, input->turns[i], input->bit_width, input->precision) - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_length_ps(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg_length(input->turns[i], input->bit_width, SERDES_TURN_DEG_MODE_PS, input->precision);
+    }
+    return sum;
+}
+
+static unsigned long bench_conv_decimal_ps(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        int exponent;
+        sum += conv_turn_to_deg_decimal(input->turns[i], input->bit_width, SERDES_TURN_DEG_MODE_PS, input->precision, &exponent);
+        sum += (unsigned int)exponent;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_incremental(const struct Input *input)
+{
+    struct serdes_turn_deg_serializer serializer;
+    unsigned long sum = 0;
+    size_t i;
+    init_turn_to_deg_serializer(&serializer, input->bit_width, SERDES_TURN_DEG_MODE_PS, input->precision);
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg_incremental(&serializer, input->buf, input->turns[i]) - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_three(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += serialize_turn_to_deg_p(input->buf, input->turns[i], input->bit_width, 1) - input->buf;
+        sum += serialize_turn_to_deg_ps(input->buf + BUF_SIZE, input->turns[i], input->bit_width, input->precision) - input->buf;
+        sum += serialize_turn_to_deg(input->buf + BUF_SIZE * 2, input->turns[i], input->bit_width) - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_multi(const struct Input *input)
+{
+    struct serdes_turn_deg_output outputs[3];
+    unsigned long sum = 0;
+    size_t i;
+    outputs[0].buf = input->buf;
+    outputs[0].mode = SERDES_TURN_DEG_MODE_P;
+    outputs[0].precision = 1;
+    outputs[1].buf = input->buf + BUF_SIZE;
+    outputs[1].mode = SERDES_TURN_DEG_MODE_PS;
+    outputs[1].precision = input->precision;
+    outputs[2].buf = input->buf + BUF_SIZE * 2;
+    outputs[2].mode = SERDES_TURN_DEG_MODE_SHORTEST;
+    outputs[2].precision = 0;
+    for (i = 0; i < input->num; i++) {
+        serialize_turn_to_deg_multi(input->turns[i], input->bit_width, outputs, 3);
+        sum += outputs[0].end - input->buf;
+        sum += outputs[1].end - input->buf;
+        sum += outputs[2].end - input->buf;
+    }
+    return sum;
+}
+
+static unsigned long bench_serialize_turns(const struct Input *input)
+{
+    return serialize_turns_to_deg(input->buf, input->turns, input->num, input->bit_width, ',') - input->buf;
+}
+
+static unsigned long bench_serialize_turns_p(const struct Input *input)
+{
+    return serialize_turns_to_deg_p(input->buf, input->turns, input->num, input->bit_width, input->precision, ',') - input->buf;
+}
+
+static unsigned long bench_serialize_turns_ps(const struct Input *input)
+{
+    return serialize_turns_to_deg_ps(input->buf, input->turns, input->num, input->bit_width, input->precision, ',') - input->buf;
+}
+
+static unsigned long bench_deserialize(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += deserialize_turn_from_deg(input->string_ptrs[i], input->bit_width, NULL);
+    }
+    return sum;
+}
+
+static unsigned long bench_deserialize_turns(const struct Input *input)
+{
+    /* reuse buf as the output, which is large enough. */
+    unsigned int *turns = (unsigned int *)(void *)input->buf;
+    const size_t n = deserialize_turns_from_deg(input->joined_strings, input->joined_len, ',', input->bit_width, turns, input->num, NULL, NULL);
+    return n + turns[n / 2];
+}
+
+/** Sum the turns that a streaming parser calls back. */
+static void sum_turn(void *context, unsigned int turn, int result)
+{
+    *(unsigned long *)context += turn + (unsigned int)result;
+}
+
+static unsigned long bench_deserialize_turns_chunk(const struct Input *input)
+{
+    /* The chunks of a pipe, which split some fields. */
+    const size_t chunk_len = 4096;
+    struct serdes_turn_deg_parser parser;
+    unsigned long sum = 0;
+    size_t i;
+    init_turns_from_deg_parser(&parser, ',', input->bit_width, sum_turn, &sum);
+    for (i = 0; i < input->joined_len; i += chunk_len) {
+        deserialize_turns_from_deg_chunk(&parser, input->joined_strings + i, input->joined_len - i < chunk_len ? input->joined_len - i : chunk_len);
+    }
+    finish_turns_from_deg_parser(&parser);
+    return sum;
+}
+
+static unsigned long bench_conv_deg_to_turn(const struct Input *input)
+{
+    unsigned long sum = 0;
+    size_t i;
+    for (i = 0; i < input->num; i++) {
+        sum += conv_deg_to_turn(input->degs[i], input->bit_width);
+    }
+    return sum;
+}
+
+static unsigned long bench_conv_degs_to_turns(const struct Input *input)
+{
+    /* reuse buf as the output, which is large enough. */
+    unsigned int *turns = (unsigned int *)(void *)input->buf;
+    conv_degs_to_turns(input->degs, input->num, input->bit_width, turns);
+    return turns[input->num / 2];
+}
+
+static const struct Bench benches[] = {
+    { "serialize_turn_to_deg", bench_serialize, 0 },
+    { "serialize_turn_to_deg_p", bench_serialize_p, 1 },
+    { "serialize_turn_to_deg_ps", bench_serialize_ps, 1 },
+    { "serialize_turn_to_deg_incremental", bench_serialize_incremental, 1 },
+    { "serialize_turn_to_deg_length (ps)", bench_serialize_length_ps, 1 },
+    { "conv_turn_to_deg_decimal (ps)", bench_conv_decimal_ps, 1 },
+    { "separate calls (p1, ps, shortest)", bench_serialize_three, 1 },
+    { "serialize_turn_to_deg_multi (p1, ps, shortest)", bench_serialize_multi, 1 },
+    { "serialize_turns_to_deg", bench_serialize_turns, 0 },
+    { "serialize_turns_to_deg_p", bench_serialize_turns_p, 1 },
+    { "serialize_turns_to_deg_ps", bench_serialize_turns_ps, 1 },
+    { "deserialize_turn_from_deg", bench_deserialize, 0 },
+    { "deserialize_turns_from_deg", bench_deserialize_turns, 0 },
+    { "deserialize_turns_from_deg_chunk", bench_deserialize_turns_chunk, 0 },
+    { "conv_deg_to_turn", bench_conv_deg_to_turn, 0 },
+    { "conv_degs_to_turns", bench_conv_degs_to_turns, 0 },
+};
+
+
+/** Parse a comma separated list of integers.
+    \return The number of integers, or -1 if the list is invalid.
+*/
+static int parse_list(const char *arg, int *list, const int min_value, const int max_value)
+{
+    int n = 0;
+    while (*arg != '\0') {
+        char *end;
+        const long value = strtol(arg, &end, 10);
+        if (end == arg || value < min_value || value > max_value || n >= MAX_LIST_SIZE) {
+            return -1;
+        }
+        list[n++] = (int)value;
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        arg = end;
+    }
+    return n;
+}
+
+
+/** Allocate the buffers of the input. */
+static int alloc_input(struct Input *input, const size_t num)
+{
+    memset(input, 0, sizeof(*input));
+    input->num = num;
+    input->turns = malloc(num * sizeof(input->turns[0]));
+    input->strings = malloc(num * BUF_SIZE);
+    input->string_ptrs = malloc(num * sizeof(input->string_ptrs[0]));
+    input->joined_strings = malloc(BATCH_BUF_SIZE(num));
+    input->degs = malloc(num * sizeof(input->degs[0]));
+    input->buf = malloc(BATCH_BUF_SIZE(num) + num * sizeof(unsigned int));
+    return input->turns != NULL && input->strings != NULL && input->string_ptrs != NULL &&
+        input->joined_strings != NULL && input->degs != NULL && input->buf != NULL;
+}
+
+static void free_input(struct Input *input)
+{
+    free(input->turns);
+    free(input->strings);
+    free(input->string_ptrs);
+    free(input->joined_strings);
+    free(input->degs);
+    free(input->buf);
+}
+
+/** Make the input angles in the distribution. */
+static void make_input(struct Input *input, const unsigned int bit_width, const enum Distribution dist)
+{
+    const unsigned int mask = 0xFFFFFFFFu >> (32 - bit_width);
+    unsigned int centers[NUM_OF_CLUSTERS];
+    /* A cluster spreads over about 1/64 of the circle. */
+    const unsigned int spread_mask = mask >> 6;
+    char *p;
+    size_t i;
+
+    input->bit_width = bit_width;
+    random_state = 88172645463325252ull;
+    for (i = 0; i < NUM_OF_CLUSTERS; i++) {
+        centers[i] = (unsigned int)next_random() & mask;
+    }
+    for (i = 0; i < input->num; i++) {
+        switch (dist) {
+        case DIST_SEQUENTIAL:
+            input->turns[i] = (unsigned int)i & mask;
+            break;
+        case DIST_UNIFORM:
+            input->turns[i] = (unsigned int)next_random() & mask;
+            break;
+        default: {
+            const unsigned long long r = next_random();
+            input->turns[i] = (centers[r % NUM_OF_CLUSTERS] + ((unsigned int)(r >> 32) & spread_mask)) & mask;
+            break;
+        }
+        }
+    }
+
+    p = input->strings;
+    for (i = 0; i < input->num; i++) {
+        input->string_ptrs[i] = p;
+        p = serialize_turn_to_deg(p, input->turns[i], bit_width) + 1;
+        input->degs[i] = (double)input->turns[i] * 360.0 / ((double)mask + 1.0);
+    }
+    input->joined_len = serialize_turns_to_deg(input->joined_strings, input->turns, input->num, bit_width, ',') - input->joined_strings;
+}
+
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** Measure a function.
+    \return The time per an angle in nanoseconds.
+*/
+static double measure(const struct Bench *bench, const struct Input *input, const double min_seconds, unsigned long *sink)
+{
+    unsigned long passes = 0;
+    double start;
+    double elapsed;
+
+    /* warm up */
+    *sink += bench->func(input);
+    start = now_seconds();
+    do {
+        *sink += bench->func(input);
+        passes++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < min_seconds);
+    return elapsed * 1e9 / ((double)passes * (double)input->num);
+}
+
+
+static void print_header(const enum OutputFormat format)
+{
+    switch (format) {
+    case FORMAT_TEXT:
+        printf("%-28s %9s %9s %-10s %10s %14s\n", "function", "bit_width", "precision", "input", "ns/op", "values/s");
+        break;
+    case FORMAT_JSON:
+        fputs("{\n  \"results\": [", stdout);
+        break;
+    case FORMAT_CSV:
+        puts("function,bit_width,precision,input,ns_per_op,values_per_s");
+        break;
+    }
+}
+
+static void print_result(const enum OutputFormat format, const int first, const struct Bench *bench, const unsigned int bit_width, const int precision, const enum Distribution dist, const double ns_per_op)
+{
+    const double values_per_s = 1e9 / ns_per_op;
+    char precision_str[16];
+    if (bench->uses_precision) {
+        sprintf(precision_str, "%d", precision);
+    } else {
+        strcpy(precision_str, format == FORMAT_TEXT ? "-" : format == FORMAT_JSON ? "null" : "");
+    }
+    switch (format) {
+    case FORMAT_TEXT:
+        printf("%-28s %9u %9s %-10s %10.2f %14.0f\n", bench->name, bit_width, precision_str, dist_name[dist], ns_per_op, values_per_s);
+        break;
+    case FORMAT_JSON:
+        printf("%s\n    {\"function\": \"%s\", \"bit_width\": %u, \"precision\": %s, \"input\": \"%s\", \"ns_per_op\": %.3f, \"values_per_s\": %.0f}",
+               first ? "" : ",", bench->name, bit_width, precision_str, dist_name[dist], ns_per_op, values_per_s);
+        break;
+    case FORMAT_CSV:
+        printf("%s,%u,%s,%s,%.3f,%.0f\n", bench->name, bit_width, precision_str, dist_name[dist], ns_per_op, values_per_s);
+        break;
+    }
+}
+
+static void print_footer(const enum OutputFormat format)
+{
+    if (format == FORMAT_JSON) {
+        fputs("\n  ]\n}\n", stdout);
+    }
+}
+
+
+static void usage(void)
+{
+    fputs("Usage: bench_serdes_turn_deg [-f text|json|csv] [-w BIT_WIDTH[,BIT_WIDTH...]] [-p PRECISION[,PRECISION...]] [-n NUM] [-t SECONDS]\n", stderr);
+}
+
+int main(int argc, char *argv[])
+{
+    enum OutputFormat format = FORMAT_TEXT;
+    int bit_widths[MAX_LIST_SIZE] = { 8, 12, 16, 22 };
+    int num_of_bit_widths = 4;
+    int precisions[MAX_LIST_SIZE] = { 0, 2, 4 };
+    int num_of_precisions = 3;
+    size_t num = DEFAULT_NUM_OF_ANGLES;
+    double min_seconds = DEFAULT_MIN_SECONDS;
+    struct Input input;
+    unsigned long sink = 0;
+    int first = 1;
+    int i;
+
+#ifdef SERDES_TURN_DEG_WIDE
+    bit_widths[num_of_bit_widths++] = MAX_BIT_WIDTH;
+#endif
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "text") == 0) {
+                format = FORMAT_TEXT;
+            } else if (strcmp(argv[i], "json") == 0) {
+                format = FORMAT_JSON;
+            } else if (strcmp(argv[i], "csv") == 0) {
+                format = FORMAT_CSV;
+            } else {
+                fprintf(stderr, "Invalid format: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            num_of_bit_widths = parse_list(argv[++i], bit_widths, SERDES_TURN_DEG_MIN_BIT_WIDTH, MAX_BIT_WIDTH);
+            if (num_of_bit_widths <= 0) {
+                fprintf(stderr, "Invalid bit-width list: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            num_of_precisions = parse_list(argv[++i], precisions, SERDES_TURN_DEG_MIN_PRECISION, MAX_PRECISION);
+            if (num_of_precisions <= 0) {
+                fprintf(stderr, "Invalid precision list: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            const long value = strtol(argv[++i], NULL, 10);
+            if (value <= 0) {
+                fprintf(stderr, "Invalid number of angles: %s\n", argv[i]);
+                return 1;
+            }
+            num = (size_t)value;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            min_seconds = strtod(argv[++i], NULL);
+            if (!(min_seconds >= 0.0)) {
+                fprintf(stderr, "Invalid time: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!alloc_input(&input, num)) {
+        fputs("Out of memory\n", stderr);
+        free_input(&input);
+        return 1;
+    }
+    print_header(format);
+    for (i = 0; i < num_of_bit_widths; i++) {
+        int dist;
+        for (dist = 0; dist < NUM_OF_DISTS; dist++) {
+            size_t b;
+            make_input(&input, (unsigned int)bit_widths[i], (enum Distribution)dist);
+            for (b = 0; b < NUM_OF(benches); b++) {
+                int j;
+                for (j = 0; j < (benches[b].uses_precision ? num_of_precisions : 1); j++) {
+                    double ns_per_op;
+                    input.precision = precisions[j];
+                    ns_per_op = measure(&benches[b], &input, min_seconds, &sink);
+                    print_result(format, first, &benches[b], input.bit_width, input.precision, (enum Distribution)dist, ns_per_op);
+                    first = 0;
+                }
+            }
+        }
+    }
+    print_footer(format);
+    free_input(&input);
+
+    /* Use the results of the functions. */
+    return sink == 1 ? 2 : 0;
+}
@@ -37,6 +37,17 @@
 #include <limits.h>
 #include <math.h>
 #include <stddef.h>
+#include <string.h>
+
+#if !defined(SERDES_TURN_DEG_DEBUG_NO_SIMD) && (defined(__AVX2__) || defined(__AVX512F__))
+#include <immintrin.h>
+#elif !defined(SERDES_TURN_DEG_DEBUG_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#endif
+
+#ifdef SERDES_TURN_DEG_PTHREAD
+#include <pthread.h>
+#endif
 
 #include "serdes_turn_deg.h"
 
@@ -44,18 +55,98 @@
 #error UINT_MAX is too small.
 #endif
 
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the functions accept in this build. */
+#define SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the functions accept in this build. */
+#define SERDES_TURN_DEG_BUILD_MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length for SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH and SERDES_TURN_DEG_BUILD_MAX_PRECISION. */
+#define SERDES_TURN_DEG_BUILD_BUF_SIZE SERDES_TURN_DEG_WIDE_BUF_SIZE
+#else
+#define SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define SERDES_TURN_DEG_BUILD_MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define SERDES_TURN_DEG_BUILD_BUF_SIZE SERDES_TURN_DEG_BUF_SIZE
+#endif
+
 /** The highest place of digit in the serialized string. */
 #define SERDES_TURN_DEG_MAX_PLACE (-SERDES_TURN_DEG_MIN_PRECISION)
 /** The lowest place of digit in the serialized string. */
-#define SERDES_TURN_DEG_MIN_PLACE (-SERDES_TURN_DEG_MAX_PRECISION)
+#define SERDES_TURN_DEG_MIN_PLACE (-SERDES_TURN_DEG_BUILD_MAX_PRECISION)
 
-#if SERDES_TURN_DEG_BUF_SIZE < SERDES_TURN_DEG_MAX_PLACE - SERDES_TURN_DEG_MIN_PLACE + 1 + 2 /* digits, decimal point, and NUL */
+#if SERDES_TURN_DEG_BUF_SIZE < SERDES_TURN_DEG_MAX_PLACE + SERDES_TURN_DEG_MAX_PRECISION + 1 + 2 /* digits, decimal point, and NUL */
 #error SERDES_TURN_DEG_BUF_SIZE is too small.
 #endif
+#if SERDES_TURN_DEG_BUILD_BUF_SIZE < SERDES_TURN_DEG_MAX_PLACE - SERDES_TURN_DEG_MIN_PLACE + 1 + 2
+#error SERDES_TURN_DEG_BUILD_BUF_SIZE is too small.
+#endif
+
+#if !defined(SERDES_TURN_DEG_DEBUG_NO_SIMD) && defined(__AVX512F__)
+/** Use AVX-512 to convert degrees. */
+#define SERDES_TURN_DEG_USE_AVX512
+#endif
+#if !defined(SERDES_TURN_DEG_DEBUG_NO_SIMD) && defined(__AVX2__)
+/** Use AVX2 to scan a text, to convert degrees, and to serialize 8 angles at once. */
+#define SERDES_TURN_DEG_USE_AVX2
+#endif
+#if !defined(SERDES_TURN_DEG_DEBUG_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+/** Use SSE2 to scan a text. */
+#define SERDES_TURN_DEG_USE_SSE2
+#endif
+
+#ifndef SERDES_TURN_DEG_DEBUG_NO_SWAR
+#if (ULONG_MAX >> 31 >> 31) == 3
+/** The number of the characters that SWAR (SIMD within a register) checks at once in unsigned long. */
+#define SWAR_BYTES 8
+/** 1 in each byte of SWAR_BYTES. */
+#define SWAR_ONES 0x0101010101010101ul
+#else
+/* unsigned long has at least 32 bits. */
+#define SWAR_BYTES 4
+#define SWAR_ONES 0x01010101ul
+#endif
+#endif
+#if !defined(SERDES_TURN_DEG_DEBUG_NO_SWAR) && defined(SERDES_TURN_DEG_WIDE) && SWAR_BYTES == 8
+/** Use SWAR in unsigned long that has just 64 bits to convert 8 digits at once. */
+#define SERDES_TURN_DEG_USE_SWAR
+#endif
+
+/** The maximum bit-width that conv_turn_to_deg_digit_array() calculates in unsigned int. */
+#define SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH 22
+/** The lowest place of digit that conv_turn_to_deg_digit_array() calculates in unsigned int. */
+#define SERDES_TURN_DEG_NARROW_MIN_PLACE (-SERDES_TURN_DEG_MAX_PRECISION)
+
+#if defined(SERDES_TURN_DEG_WIDE) && (ULONG_MAX >> 31 >> 31) == 3
+/** Divide by the multiplication by the reciprocal in unsigned long that has just 64 bits to deserialize. */
+#define SERDES_TURN_DEG_USE_MAGIC_DIVISION
+#endif
+
+/** The mask of the valid bits in a turn. It's valid even if bit_width is the bit-width of unsigned int. */
+#define TURN_MASK(bit_width) ((((1u << ((bit_width) - 1)) - 1) << 1) | 1u)
+
+#ifdef SERDES_TURN_DEG_DIGIT_ENGINE_RECIPROCAL
+/** The digit at the place of interest in R, that is R / S, without the division.
+    \param [in] R Remain. R / 2**bit_width must be less than 1000.
+    \param [in] S The place of interest in R. It must be 100 * 2**bit_width.
+    \param [in] bit_width The bit-width of the turn.
+
+    R / S is (R >> bit_width) / 100, and (x * 41) >> 12 is the same as x / 100 for x in [0, 1000).
+*/
+#define NEXT_DIGIT(R, S, bit_width) ((((R) >> (bit_width)) * 41) >> 12)
+#else
+/** The digit at the place of interest in R, that is R / S.
+    \param [in] R Remain.
+    \param [in] S The place of interest in R.
+    \param [in] bit_width The bit-width of the turn.
+*/
+#define NEXT_DIGIT(R, S, bit_width) ((R) / (S))
+#endif
 
 /** The index that is equivalent the place\#k. */
 #define BUF_INDEX(k) (SERDES_TURN_DEG_MAX_PLACE - (k))
 
+/** Whether a character is a digit. Unlike isdigit(), it doesn't depend on the locale, the same as SWAR and SIMD. */
+#define IS_DIGIT(c) ('0' <= (c) && (c) <= '9')
+
 /** Make sure the parameter is in range.
     \param [inout] param The parameter to check.
     \param [in] minimum The minimum acceptable value.
@@ -73,12 +164,116 @@
     } while (0)
 
 
+#ifdef SERDES_TURN_DEG_STATS
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SERDES_TURN_DEG_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define SERDES_TURN_DEG_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define SERDES_TURN_DEG_THREAD_LOCAL __declspec(thread)
+#else
+#error SERDES_TURN_DEG_STATS needs the thread local storage.
+#endif
+/** The statistics of the calls in the thread. */
+static SERDES_TURN_DEG_THREAD_LOCAL struct serdes_turn_deg_stats thread_stats;
+/** Add n to a counter of the statistics. */
+#define STATS_ADD(member, n) (thread_stats.member += (n))
+#else
+/* No code, but the operands are still used to avoid the warnings of the unused variables. */
+#define STATS_ADD(member, n) ((void)sizeof(((struct serdes_turn_deg_stats *)0)->member + (n)))
+#endif
+/** The bin of a histogram of the statistics. */
+#define STATS_BIN(value, num_of_bins) ((size_t)(value) < (num_of_bins) ? (size_t)(value) : (num_of_bins) - 1)
+
+
+#if defined(SERDES_TURN_DEG_USE_SSE2) || defined(SERDES_TURN_DEG_USE_AVX2)
+/** Count the trailing zero bits.
+    \param [in] mask A bit mask. It must not be 0.
+    \return The number of the trailing zero bits.
+*/
+static unsigned int count_trailing_zeros(unsigned int mask)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int n = 0;
+    assert(mask != 0);
+    for (; (mask & 1) == 0; mask >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+#endif
+
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The variation of conv_turn_to_deg_digit_array() for the bit-width more than SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH or the place less than SERDES_TURN_DEG_NARROW_MIN_PLACE.
+    \param [inout] buf A buffer to output a digit array. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE - 2.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH].
+    \param [in] place The maximum place of digit to output. It must be in range [SERDES_TURN_DEG_MIN_PLACE, SERDES_TURN_DEG_MAX_PLACE].
+    \return The minimum place of digit to output.
+
+    This function calculates in unsigned long that has 64 bits at least.
+*/
+static int conv_turn_to_deg_digit_array_wide(char *buf, unsigned int turn, unsigned int bit_width, int place)
+{
+    unsigned long R;  /* Remain? */
+    unsigned long S;  /* The place of interest in R */
+    unsigned long M;  /* Margin? */
+    int low; /* matched low side */
+    int high; /* matched high side */
+    int k; /* the place of digit */
+
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= bit_width && bit_width <= SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    turn &= TURN_MASK(bit_width); /* clamp turn within [0, 360) degree */
+    R = (unsigned long)turn * 360; /* convert turn into degree */
+    S = (1ul << bit_width) * 100; /* 100 degree */
+    M = 180; /* equivalent to LSB/2 in turn */
+
+    k = SERDES_TURN_DEG_MAX_PLACE + 1;
+    low = 0;
+    high = 0;
+    while (!low && !high) {
+        unsigned long U = NEXT_DIGIT(R, S, bit_width); /* candidate for the digit */
+        k--;
+        R = R - U * S;
+        if (k <= place) {
+            low = R < M;
+            high = R + M > S;
+            if (high && (!low || R >= S / 2)) {
+                /* if k < 2 && k == place && high, U may be 10. */
+                U++;
+            }
+        }
+        buf[BUF_INDEX(k)] = (char)U;
+        R *= 10;
+        M *= 10;
+        if (M > S) {
+            /* M > S means low is true, and then high is the same as R > 0 and doesn't affect U. */
+            M = S;
+        }
+
+        assert(k >= SERDES_TURN_DEG_MIN_PLACE);
+        if (k == SERDES_TURN_DEG_MIN_PLACE) {
+            assert(low || high);
+            break;
+        }
+    }
+    return k;
+}
+#endif
+
+
 /** Convert an angle @ turn to the digit array @ degree.
-    \param [inout] buf A buffer to output a digit array. The length must be at least SERDES_TURN_DEG_BUF_SIZE - 2.
+    \param [inout] buf A buffer to output a digit array. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE - 2.
     \param [in] turn The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place. It means the angle as an integer is in range [0, 2**bit_width - 1], that is [0, 1) turn = [0, 360) degree.
-    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH].
     \param [in] place The maximum place of digit to output. It must be in range [SERDES_TURN_DEG_MIN_PLACE, SERDES_TURN_DEG_MAX_PLACE].
     \return The minimum place of digit to output.
+    \pre bit_width and place are in range. The caller is responsible for the check.
     \warning The return value is longer than the specified place if it's not enough to deserialize to the same angle.
     \warning The lowest place in the return value may be 10 if place is less than SERDES_TURN_DEG_MAX_PLACE.
 
@@ -93,8 +288,14 @@ static int conv_turn_to_deg_digit_array(char *buf, unsigned int turn, unsigned i
     int high; /* matched high side */
     int k; /* the place of digit */
 
-    PARAM_CHECK(place, SERDES_TURN_DEG_MIN_PLACE, SERDES_TURN_DEG_MAX_PLACE);
-    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH);
+    assert(SERDES_TURN_DEG_MIN_PLACE <= place && place <= SERDES_TURN_DEG_MAX_PLACE);
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= bit_width && bit_width <= SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+#ifdef SERDES_TURN_DEG_WIDE
+    if (bit_width > SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH || place < SERDES_TURN_DEG_NARROW_MIN_PLACE) {
+        return conv_turn_to_deg_digit_array_wide(buf, turn, bit_width, place);
+    }
+#endif
 
     turn &= (1u << bit_width) - 1; /* clamp turn within [0, 360) degree */
     R = turn * 360; /* convert turn into degree */
@@ -105,7 +306,7 @@ static int conv_turn_to_deg_digit_array(char *buf, unsigned int turn, unsigned i
     low = 0;
     high = 0;
     while (!low && !high) {
-        unsigned int U = R / S; /* candidate for the digit */
+        unsigned int U = NEXT_DIGIT(R, S, bit_width); /* candidate for the digit */
         k--;
         R = R - U * S;
         if (k <= place) {
@@ -117,8 +318,110 @@ static int conv_turn_to_deg_digit_array(char *buf, unsigned int turn, unsigned i
             }
         }
         buf[BUF_INDEX(k)] = U;
-        R *= 10; /* The maximum R may be 999.991 * (1u << bit_width), so SERDES_TURN_DEG_MAX_BIT_WIDTH is 32 - 10. */
+        R *= 10; /* The maximum R may be 999.991 * (1u << bit_width), so SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH is 32 - 10. */
+        M *= 10;
+
+        assert(k >= SERDES_TURN_DEG_NARROW_MIN_PLACE);
+        if (k == SERDES_TURN_DEG_NARROW_MIN_PLACE) {
+            assert(low || high);
+            break;
+        }
+    }
+    return k;
+}
+
+
+/** The variation of conv_turn_to_deg_digit_array() that reuses the digits of the previous angle.
+    \param [inout] serializer The state of the serializer, which keeps the digits and the remainders of the previous angle.
+    \param [inout] buf A buffer to output a digit array. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE - 2.
+    \param [in] turn The angle @ turn.
+    \return The minimum place of digit to output.
+    \pre serializer->bit_width is in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+
+    The digits of turn * 360 / S from the place\#2 to the place\#k are the same as the previous angle if the remainder at the place\#k plus the difference of the angles (multiplied by 360 * 10**(2 - k)) is still in [0, S). Then the remainder is updated without the division, and the digit is reused.
+*/
+static int conv_turn_to_deg_digit_array_incremental(struct serdes_turn_deg_serializer *const serializer, char *buf, unsigned int turn)
+{
+    const unsigned int bit_width = serializer->bit_width;
+    const int place = serializer->place;
+    char *const digits = serializer->digits;
+    unsigned int *const remainders = serializer->remainders;
+    unsigned int R;  /* Remain? */
+    unsigned int S;  /* The place of interest in R */
+    unsigned int M;  /* Margin? */
+    int low; /* matched low side */
+    int high; /* matched high side */
+    int k; /* the place of digit */
+
+    assert(SERDES_TURN_DEG_MIN_PLACE <= place && place <= SERDES_TURN_DEG_MAX_PLACE);
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= bit_width && bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH);
+
+    turn &= (1u << bit_width) - 1; /* clamp turn within [0, 360) degree */
+    R = turn * 360; /* convert turn into degree */
+    S = (1u << bit_width) * 100; /* 100 degree */
+    M = 180; /* equivalent to LSB/2 in turn */
+
+    k = SERDES_TURN_DEG_MAX_PLACE + 1;
+    low = 0;
+    high = 0;
+    if (serializer->lowest_place <= SERDES_TURN_DEG_MAX_PLACE) {
+        /* Reuse the upper digits of the previous angle while they don't change. */
+        const int up = turn >= serializer->turn;
+        unsigned int D = (up ? turn - serializer->turn : serializer->turn - turn) * 360; /* The difference of the angles at the place of interest */
+        while (k > serializer->lowest_place && D < S) {
+            const unsigned int previous_R = remainders[BUF_INDEX(k - 1)];
+            unsigned int U;
+            if (up ? previous_R >= S - D : previous_R < D) {
+                /* The digit changes. */
+                break;
+            }
+            k--;
+            R = up ? previous_R + D : previous_R - D;
+            remainders[BUF_INDEX(k)] = R;
+            U = digits[BUF_INDEX(k)];
+            if (k <= place) {
+                low = R < M;
+                high = R + M > S; /* R > S - M can be overflow */
+                if (high && (!low || R >= S / 2)) {
+                    /* if k < 2 && k == place && high, U may be 10. */
+                    U++;
+                }
+            }
+            buf[BUF_INDEX(k)] = U;
+            if (low || high) {
+                break;
+            }
+            D *= 10; /* D < S, so it doesn't overflow as well as R. */
+            M *= 10;
+            if (M > S) {
+                M = S;
+            }
+        }
+        if (k <= SERDES_TURN_DEG_MAX_PLACE) {
+            R = remainders[BUF_INDEX(k)] * 10;
+        }
+    }
+
+    /* Generate the lower digits as conv_turn_to_deg_digit_array() does. */
+    while (!low && !high) {
+        unsigned int U = NEXT_DIGIT(R, S, bit_width); /* candidate for the digit */
+        k--;
+        R = R - U * S;
+        digits[BUF_INDEX(k)] = U;
+        remainders[BUF_INDEX(k)] = R;
+        if (k <= place) {
+            low = R < M;
+            high = R + M > S; /* R > S - M can be overflow */
+            if (high && (!low || R >= S / 2)) {
+                U++;
+            }
+        }
+        buf[BUF_INDEX(k)] = U;
+        R *= 10;
         M *= 10;
+        if (M > S) {
+            M = S;
+        }
 
         assert(k >= SERDES_TURN_DEG_MIN_PLACE);
         if (k == SERDES_TURN_DEG_MIN_PLACE) {
@@ -126,6 +429,8 @@ static int conv_turn_to_deg_digit_array(char *buf, unsigned int turn, unsigned i
             break;
         }
     }
+    serializer->turn = turn;
+    serializer->lowest_place = k;
     return k;
 }
 
@@ -141,6 +446,7 @@ static int conv_turn_to_deg_digit_array(char *buf, unsigned int turn, unsigned i
 static void carry_up_overflow(char *digit_array, const int lowest_place)
 {
     int k;
+    STATS_ADD(carries, digit_array[BUF_INDEX(lowest_place)] == 10);
     for (k = lowest_place; k < SERDES_TURN_DEG_MAX_PLACE; k++) {
         if (digit_array[BUF_INDEX(k)] == 10) {
             digit_array[BUF_INDEX(k)] = 0;
@@ -159,9 +465,9 @@ static void carry_up_overflow(char *digit_array, const int lowest_place)
 
 
 /** Convert a digit array @ degree to the string.
-    \param [inout] dest A buffer to output a string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
+    \param [inout] dest A buffer to output a string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
     \param [in] src A digit array to convert.
-    \param [in] lowest_place The lowest place of src.
+    \param [in] lowest_place The lowest place of src. It must be in range [SERDES_TURN_DEG_MIN_PLACE, SERDES_TURN_DEG_MAX_PLACE].
     \return The point to NUL character in buf.
     \note src can overlap the area beyond dest + 1 (including dest + 1).
     \verbatim
@@ -186,7 +492,7 @@ static char *conv_deg_digit_array_to_string(char *dest, const char *src, int low
     int k = SERDES_TURN_DEG_MAX_PLACE;
     char *const dest_begin = dest;
 
-    PARAM_CHECK(lowest_place, SERDES_TURN_DEG_MIN_PLACE, SERDES_TURN_DEG_MAX_PLACE);
+    assert(SERDES_TURN_DEG_MIN_PLACE <= lowest_place && lowest_place <= SERDES_TURN_DEG_MAX_PLACE);
 
     for (; k >= lowest_place; k--) {
         if (k > 0 && *src == 0 && dest == dest_begin) {
@@ -209,39 +515,145 @@ static char *conv_deg_digit_array_to_string(char *dest, const char *src, int low
         }
     }
     *dest = '\0';
-    assert(src - src_begin < SERDES_TURN_DEG_BUF_SIZE);
-    assert(dest - dest_begin < SERDES_TURN_DEG_BUF_SIZE);
+    assert(src - src_begin < SERDES_TURN_DEG_BUILD_BUF_SIZE);
+    assert(dest - dest_begin < SERDES_TURN_DEG_BUILD_BUF_SIZE);
+    STATS_ADD(serialized_length[dest - dest_begin], 1);
     return dest;
 }
 
 
-/* external functions */
+#ifdef SERDES_TURN_DEG_SINGLE_PASS
+/** Serialize an angle @ turn to the string in a single pass, without the digit array.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+    \param [in] place The maximum place of digit to output.
+    \param [in] suppress Nonzero to suppress a series of the lowest side 0 like conv_turn_to_deg_string_ps().
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
 
-char *serialize_turn_to_deg(char *buf, const unsigned int turn, const unsigned int bit_width)
+    This function writes the characters while conv_turn_to_deg_digit_array() generates the digits, and then handles the overflow of the lowest digit and the suppression at the tail of the string.
+*/
+static char *conv_turn_to_deg_text(char *buf, unsigned int turn, const unsigned int bit_width, const int place, const int suppress)
 {
-    char *const digit_array = buf + 1;
-    const int lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, SERDES_TURN_DEG_MAX_PLACE);
-    /* no need to carry up. */
-    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
-}
+    char *dest = buf;
+    char *point = NULL; /* the decimal point in buf */
+    unsigned int R;
+    unsigned int S;
+    unsigned int M;
+    unsigned int U;
+    int low = 0;
+    int high = 0;
+    int k = SERDES_TURN_DEG_MAX_PLACE + 1;
 
+    assert(SERDES_TURN_DEG_MIN_PLACE <= place && place <= SERDES_TURN_DEG_MAX_PLACE);
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= bit_width && bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH);
 
-char *serialize_turn_to_deg_p(char *buf, const unsigned int turn, const unsigned int bit_width, const int precision)
-{
-    char *const digit_array = buf + 1;
-    const int lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, -precision);
-    carry_up_overflow(digit_array, lowest_place);
-    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+    turn &= (1u << bit_width) - 1; /* clamp turn within [0, 360) degree */
+    R = turn * 360;
+    S = (1u << bit_width) * 100;
+    M = 180;
+    for (;;) {
+        U = NEXT_DIGIT(R, S, bit_width);
+        k--;
+        R = R - U * S;
+        if (k <= place) {
+            low = R < M;
+            high = R + M > S;
+            if (high && (!low || R >= S / 2)) {
+                U++;
+            }
+        }
+        if (low || high || k == SERDES_TURN_DEG_MIN_PLACE) {
+            /* the lowest digit */
+            break;
+        }
+        if (k == -1) {
+            point = dest;
+            *dest++ = '.';
+        }
+        if (U != 0 || dest != buf || k <= 0) { /* Zero suppress */
+            *dest++ = '0' + U;
+        }
+        R *= 10;
+        M *= 10;
+        if (M > S) {
+            M = S;
+        }
+    }
+    assert(low || high);
+
+    if (k == -1) {
+        point = dest;
+        *dest++ = '.';
+    }
+    if (U < 10) {
+        if (U != 0 || dest != buf || k <= 0) {
+            *dest++ = '0' + U;
+        }
+    } else {
+        /* Carry up the overflow of the lowest digit, which is possible if k == place. */
+        char *p = dest;
+        int carry = 1;
+        STATS_ADD(carries, 1);
+        *dest++ = '0';
+        while (carry && p != buf) {
+            p--;
+            if (*p == '.') {
+                continue;
+            }
+            if (*p == '9') {
+                *p = '0';
+            } else {
+                (*p)++;
+                carry = 0;
+            }
+        }
+        if (carry) {
+            /* All the digits are 0 now, so put 1 at the top, and the integer part gets a digit. */
+            *buf = '1';
+            *dest++ = '0';
+            if (point != NULL) {
+                *point++ = '0';
+                *point = '.';
+            }
+        }
+    }
+    if (dest == buf) {
+        /* This condition can be true if the lowest place > 0. */
+        *dest++ = '0';
+    } else {
+        /* The integer part needs to be filled with '0'. */
+        for (; k > 0; k--) {
+            *dest++ = '0';
+        }
+    }
+    if (suppress && point != NULL) {
+        /* suppress lower zero */
+        STATS_ADD(suppressions, dest[-1] == '0');
+        while (dest[-1] == '0') {
+            dest--;
+        }
+        if (dest[-1] == '.') {
+            dest--;
+        }
+    }
+    *dest = '\0';
+    assert(dest - buf < SERDES_TURN_DEG_BUILD_BUF_SIZE);
+    STATS_ADD(serialized_length[dest - buf], 1);
+    return dest;
 }
+#endif
 
 
-char *serialize_turn_to_deg_ps(char *buf, const unsigned int turn, const unsigned int bit_width, const int precision)
+/** Suppress a series of the lowest side 0 in the decimal places of a digit array.
+    \param [in] digit_array A digit array @ degree.
+    \param [in] lowest_place The lowest place of digit_array.
+    \return The lowest place after the suppression.
+*/
+static int suppress_lower_zero(const char *digit_array, int lowest_place)
 {
-    char *const digit_array = buf + 1;
-    int lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, -precision);
-    carry_up_overflow(digit_array, lowest_place);
-
-    /* suppress lower zero */
+    STATS_ADD(suppressions, lowest_place < 0 && digit_array[BUF_INDEX(lowest_place)] == 0);
     while (lowest_place < 0) {
         if (digit_array[BUF_INDEX(lowest_place)] == 0) {
             lowest_place++;
@@ -249,96 +661,1897 @@ char *serialize_turn_to_deg_ps(char *buf, const unsigned int turn, const unsigne
             break;
         }
     }
-    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+    return lowest_place;
 }
 
 
-unsigned int deserialize_turn_from_deg(const char *const serialized_deg, const unsigned int bit_width, const char **const endptr)
+/** Serialize an angle @ turn to the shortest string.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \return The point to NUL character in buf.
+    \pre bit_width is in range. The caller is responsible for the check.
+*/
+static char *conv_turn_to_deg_string(char *buf, const unsigned int turn, const unsigned int bit_width)
 {
-    unsigned int deg = 0;
-    unsigned int turn;
-    unsigned int S;
-    int count = 0;
-    /* parse serialized_deg */
-    const char *ptr = serialized_deg;
-    for (; *ptr != '\0'; ptr++) {
-        if (!isspace((unsigned char)*ptr)) {
-            break;
-        }
-    }
-    for (; *ptr != '\0' && isdigit((unsigned char)*ptr) && count <= SERDES_TURN_DEG_MAX_PLACE; ptr++) {
-        deg *= 10;
-        deg += *ptr - '0';
-        count++;
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE]; /* not in buf, so that the batch functions write nothing after NUL */
+    int lowest_place;
+#ifdef SERDES_TURN_DEG_SINGLE_PASS
+    if (bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        return conv_turn_to_deg_text(buf, turn, bit_width, SERDES_TURN_DEG_MAX_PLACE, 0);
     }
-    deg %= 360;
+#endif
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, SERDES_TURN_DEG_MAX_PLACE);
+    /* no need to carry up. */
+    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+}
 
-    S = 1;
-    if (*ptr == '.') {
-        ptr++;
-        count = 0;
-        for (; *ptr != '\0' && isdigit((unsigned char)*ptr); ptr++) {
-            if (count < -SERDES_TURN_DEG_MIN_PLACE) {
-                S *= 10;
-                deg *= 10;
-                deg += *ptr - '0';
-                count++;
-            }
-        }
-    }
-    if (endptr != NULL) {
-        *endptr = ptr;
+
+/** Serialize an angle @ turn to the string with the specified place.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \param [in] place The maximum place of digit to output.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+*/
+static char *conv_turn_to_deg_string_p(char *buf, const unsigned int turn, const unsigned int bit_width, const int place)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    int lowest_place;
+#ifdef SERDES_TURN_DEG_SINGLE_PASS
+    if (bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        return conv_turn_to_deg_text(buf, turn, bit_width, place, 0);
     }
+#endif
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, place);
+    carry_up_overflow(digit_array, lowest_place);
+    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+}
 
-    /* convert an angle @ degree to @ turn. */
 
-    /* 100000 == 10**(-SERDES_TURN_MIN_PLACE) */
-    assert(S <= 100000);
-    S *= 180;
-#if !defined(SERDES_TURN_DEG_DEBUG_FORCE_32BIT) && (ULONG_MAX >> SERDES_TURN_DEG_MAX_BIT_WIDTH) >= (100000 * 360) - 1
-    {
-        unsigned long R = deg;
-        R *= 1u << bit_width;
-        turn = R / S;
-    }
-#else
-    /* A variation of (FPP)2 in dragon4 (https://dl.acm.org/doi/10.1145/93548.93559). */
-    {
-        unsigned int R = deg;
-        unsigned int i;
-        turn = 0;
-        for (i = 0; i <= bit_width; i++) {
-            const unsigned int U = R / S;
-            R -= U * S;
-            R <<= 1;
-            turn <<= 1;
-            turn |= U;
-        }
+/** Serialize an angle @ turn to the string with the specified place, and suppress a series of the lowest side 0.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \param [in] place The maximum place of digit to output.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+*/
+static char *conv_turn_to_deg_string_ps(char *buf, const unsigned int turn, const unsigned int bit_width, const int place)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    int lowest_place;
+#ifdef SERDES_TURN_DEG_SINGLE_PASS
+    if (bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        /* The suppressed zeros are written after NUL, so the string goes through digit_array to keep them out of buf. */
+        const size_t len = (size_t)(conv_turn_to_deg_text(digit_array, turn, bit_width, place, 1) - digit_array);
+        memcpy(buf, digit_array, len + 1);
+        return buf + len;
     }
 #endif
-    if (turn & 1) {
-        turn = (turn / 2) + 1;
-    } else {
-        turn = turn / 2;
-    }
-    turn &= (1u << bit_width) - 1;
-    return turn;
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, place);
+    carry_up_overflow(digit_array, lowest_place);
+    lowest_place = suppress_lower_zero(digit_array, lowest_place);
+    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
 }
 
 
-unsigned int conv_deg_to_turn(double deg, unsigned int bit_width)
+/** The kind of the serialized string: serialize_turn_to_deg(). */
+#define SERIALIZE_KIND_SHORTEST SERDES_TURN_DEG_MODE_SHORTEST
+/** The kind of the serialized string: serialize_turn_to_deg_p(). */
+#define SERIALIZE_KIND_P SERDES_TURN_DEG_MODE_P
+/** The kind of the serialized string: serialize_turn_to_deg_ps(). */
+#define SERIALIZE_KIND_PS SERDES_TURN_DEG_MODE_PS
+
+
+/** The variation of conv_turn_to_deg_digit_array() that generates the digits for some places at once.
+    \param [out] buf A buffer to output the digits before the rounding. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE - 2.
+    \param [out] stops A buffer to output whether the generation stops at each place: 0 if it doesn't stop, 1 if it stops, or 2 if it stops with the digit rounded up. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE - 2.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+    \param [in] place The lowest one of the maximum places of digit to output.
+    \return The lowest place of the generated digits.
+
+    The digits don't depend on the maximum place to output; it only decides where the generation stops, that is, the highest place k <= the maximum place where stops[BUF_INDEX(k)] is not 0. So buf and stops have the digits for all maximum places not less than place.
+*/
+static int conv_turn_to_deg_digit_array_multi(char *buf, char *stops, unsigned int turn, unsigned int bit_width, int place)
 {
-    unsigned int turn;
+    unsigned int R;  /* Remain? */
+    unsigned int S;  /* The place of interest in R */
+    unsigned int M;  /* Margin? */
+    int k; /* the place of digit */
 
-    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH);
+    assert(SERDES_TURN_DEG_MIN_PLACE <= place && place <= SERDES_TURN_DEG_MAX_PLACE);
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= bit_width && bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH);
 
-    deg = fmod(deg, 360.0);
-    deg *= 1u << bit_width;
-    turn = (int)deg / 180;
-    if (turn & 1) {
-        turn = (turn / 2) + 1;
+    turn &= (1u << bit_width) - 1; /* clamp turn within [0, 360) degree */
+    R = turn * 360; /* convert turn into degree */
+    S = (1u << bit_width) * 100; /* 100 degree */
+    M = 180; /* equivalent to LSB/2 in turn */
+
+    k = SERDES_TURN_DEG_MAX_PLACE + 1;
+    do {
+        const unsigned int U = NEXT_DIGIT(R, S, bit_width);
+        int low; /* matched low side */
+        int high; /* matched high side */
+        k--;
+        R = R - U * S;
+        low = R < M;
+        high = R + M > S;
+        buf[BUF_INDEX(k)] = U;
+        stops[BUF_INDEX(k)] = !low && !high ? 0 : high && (!low || R >= S / 2) ? 2 : 1;
+        R *= 10;
+        M *= 10;
+        if (M > S) {
+            M = S;
+        }
+        assert(k > SERDES_TURN_DEG_MIN_PLACE || stops[BUF_INDEX(k)]);
+    } while (k > place || !stops[BUF_INDEX(k)]);
+    return k;
+}
+
+
+/** The maximum place of digit to output for a mode.
+    \param [in] mode The serialize function.
+    \param [in] precision The precision of SERDES_TURN_DEG_MODE_P and SERDES_TURN_DEG_MODE_PS.
+    \return The maximum place of digit to output.
+*/
+static int mode_to_place(const enum serdes_turn_deg_mode mode, int precision)
+{
+    if (mode == SERDES_TURN_DEG_MODE_SHORTEST) {
+        return SERDES_TURN_DEG_MAX_PLACE;
+    }
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return -precision;
+}
+
+
+/** Serialize an angle @ turn to the strings of some modes and precisions by generating the digits once.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+    \param [inout] outputs The outputs.
+    \param [in] num The number of the outputs.
+    \param [in] place The lowest one of the maximum places of digit of the outputs.
+*/
+static void conv_turn_to_deg_strings_multi(const unsigned int turn, const unsigned int bit_width, struct serdes_turn_deg_output *const outputs, const size_t num, const int place)
+{
+    char digits[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    char stops[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    size_t i;
+
+    (void)conv_turn_to_deg_digit_array_multi(digits, stops, turn, bit_width, place);
+    for (i = 0; i < num; i++) {
+        struct serdes_turn_deg_output *const output = &outputs[i];
+        char *const digit_array = output->buf + 1;
+        const int output_place = mode_to_place(output->mode, output->precision);
+        int lowest_place = output_place;
+
+        STATS_ADD(serialized_by_bit_width[bit_width], 1);
+        if (output->mode == SERDES_TURN_DEG_MODE_SHORTEST) {
+            STATS_ADD(serialized_shortest, 1);
+        } else {
+            STATS_ADD(serialized_by_precision[-output_place - SERDES_TURN_DEG_MIN_PRECISION], 1);
+        }
+        while (!stops[BUF_INDEX(lowest_place)]) {
+            lowest_place--;
+        }
+        memcpy(digit_array, digits, BUF_INDEX(lowest_place) + 1);
+        if (stops[BUF_INDEX(lowest_place)] == 2) {
+            /* It may be 10. */
+            digit_array[BUF_INDEX(lowest_place)]++;
+        }
+        carry_up_overflow(digit_array, lowest_place);
+        if (output->mode == SERDES_TURN_DEG_MODE_PS) {
+            lowest_place = suppress_lower_zero(digit_array, lowest_place);
+        }
+        output->end = conv_deg_digit_array_to_string(output->buf, digit_array, lowest_place);
+    }
+}
+
+
+#ifdef SERDES_TURN_DEG_USE_TABLE
+/** A table of the serialized strings of all angles in a bit-width.
+
+    The serialized string of turn is text[offsets[turn]] .. text[offsets[turn + 1] - 1], which doesn't contain NUL.
+*/
+struct DegTable {
+    unsigned int bit_width; /**< The bit-width of the angles. */
+    int kind; /**< SERIALIZE_KIND_* */
+    int place; /**< The maximum place of digit to output. It's SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST. */
+    const unsigned int *offsets; /**< The offsets of the strings in text. The length is 2**bit_width + 1. */
+    const char *text; /**< The serialized strings. */
+};
+
+/* The generated file defines deg_tables[] and NUM_OF_DEG_TABLES. */
+#include "serdes_turn_deg_table.h"
+
+
+/** Find the table of the serialized strings.
+    \param [in] bit_width The bit-width of the angles.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output.
+    \return The table, or NULL if no table is generated for the parameters.
+*/
+static const struct DegTable *find_deg_table(const unsigned int bit_width, const int kind, const int place)
+{
+    size_t i;
+    for (i = 0; i < NUM_OF_DEG_TABLES; i++) {
+        const struct DegTable *const table = &deg_tables[i];
+        if (table->bit_width == bit_width && table->kind == kind && table->place == place) {
+            return table;
+        }
+    }
+    return NULL;
+}
+
+
+/** Copy the serialized string from the table.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] table The table of the serialized strings.
+    \param [in] turn The angle @ turn.
+    \return The point to NUL character in buf.
+*/
+static char *copy_from_deg_table(char *buf, const struct DegTable *const table, unsigned int turn)
+{
+    size_t len;
+    turn &= TURN_MASK(table->bit_width); /* clamp turn within [0, 360) degree */
+    len = table->offsets[turn + 1] - table->offsets[turn];
+    assert(len < SERDES_TURN_DEG_BUILD_BUF_SIZE);
+    STATS_ADD(serialized_length[len], 1);
+    memcpy(buf, table->text + table->offsets[turn], len);
+    buf += len;
+    *buf = '\0';
+    return buf;
+}
+#endif /* SERDES_TURN_DEG_USE_TABLE */
+
+
+#ifdef SERDES_TURN_DEG_USE_AVX2
+/** The number of the angles that conv_turns_to_deg_digit_arrays_avx2() converts at once. */
+#define AVX2_LANES 8
+
+/** Convert 8 angles @ turn to the digit arrays @ degree at once by AVX2. The same as conv_turn_to_deg_digit_array() for each angle.
+    \param [out] digits The transposed digit arrays: digits[BUF_INDEX(k)][i] is the digit at the place k of turns[i].
+    \param [out] lowest_places The minimum places of digit to output of each angle.
+    \param [in] turns 8 angles @ turn.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+    \param [in] place The maximum place of digit to output.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+
+    S and M don't depend on the angle, so each lane runs the same steps, and only the place where the lane stops differs. A stopped lane keeps its lowest place while the others go on, and the loop ends when all lanes stop. The digits are R / S = ((R >> bit_width) * 41) >> 12 as SERDES_TURN_DEG_DIGIT_ENGINE_RECIPROCAL, because AVX2 has no division of integers.
+*/
+static void conv_turns_to_deg_digit_arrays_avx2(unsigned int digits[][AVX2_LANES], int *const lowest_places, const unsigned int *const turns, const unsigned int bit_width, const int place)
+{
+    const unsigned int S = (1u << bit_width) * 100; /* 100 degree */
+    const __m128i shift = _mm_cvtsi32_si128((int)bit_width);
+    const __m256i S_vec = _mm256_set1_epi32((int)S);
+    const __m256i half_S_minus_1 = _mm256_set1_epi32((int)(S / 2 - 1));
+    const __m256i multiplier = _mm256_set1_epi32(41);
+    const __m256i ten = _mm256_set1_epi32(10);
+    __m256i R = _mm256_loadu_si256((const __m256i *)(const void *)turns);
+    __m256i stopped = _mm256_setzero_si256();
+    __m256i lowest = _mm256_set1_epi32(SERDES_TURN_DEG_MIN_PLACE);
+    unsigned int M = 180; /* equivalent to LSB/2 in turn */
+    int k;
+
+    R = _mm256_and_si256(R, _mm256_set1_epi32((int)((1u << bit_width) - 1))); /* clamp turn within [0, 360) degree */
+    R = _mm256_mullo_epi32(R, _mm256_set1_epi32(360)); /* convert turn into degree */
+    for (k = SERDES_TURN_DEG_MAX_PLACE; ; k--) {
+        /* R is less than 2**32 but may be more than 2**31, so the shift is logical. */
+        __m256i U = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srl_epi32(R, shift), multiplier), 12);
+        R = _mm256_sub_epi32(R, _mm256_mullo_epi32(U, S_vec));
+        if (k <= place) {
+            /* R, M, and R + M are less than 2 * S < 2**31 here, so the signed comparisons are enough. */
+            const __m256i M_vec = _mm256_set1_epi32((int)M);
+            const __m256i low = _mm256_cmpgt_epi32(M_vec, R);
+            const __m256i high = _mm256_cmpgt_epi32(_mm256_add_epi32(R, M_vec), S_vec);
+            const __m256i low_not_half = _mm256_andnot_si256(_mm256_cmpgt_epi32(R, half_S_minus_1), low);
+            const __m256i stopping = _mm256_andnot_si256(stopped, _mm256_or_si256(low, high));
+            /* if high && (!low || R >= S / 2), the mask is -1, and U is incremented. */
+            U = _mm256_sub_epi32(U, _mm256_andnot_si256(low_not_half, high));
+            lowest = _mm256_blendv_epi8(lowest, _mm256_set1_epi32(k), stopping);
+            stopped = _mm256_or_si256(stopped, stopping);
+        }
+        _mm256_storeu_si256((__m256i *)(void *)digits[BUF_INDEX(k)], U);
+        if (k == SERDES_TURN_DEG_MIN_PLACE || _mm256_movemask_ps(_mm256_castsi256_ps(stopped)) == 0xFF) {
+            break;
+        }
+        R = _mm256_mullo_epi32(R, ten);
+        M *= 10;
+        if (M > S) {
+            M = S;
+        }
+    }
+    _mm256_storeu_si256((__m256i *)(void *)lowest_places, lowest);
+}
+
+/** Serialize 8 angles @ turn to the strings separated by a character by AVX2.
+    \param [inout] buf A buffer to write the serialized strings.
+    \param [in] turns 8 angles @ turn.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH].
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \param [in] separator The character to put between the serialized strings.
+    \param [in] leading_separator Nonzero to put separator before the first string.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+*/
+static char *conv_8_turns_to_deg_string_avx2(char *buf, const unsigned int *const turns, const unsigned int bit_width, const int kind, const int place, const char separator, const int leading_separator)
+{
+    unsigned int digits[SERDES_TURN_DEG_BUILD_BUF_SIZE][AVX2_LANES];
+    int lowest_places[AVX2_LANES];
+    int i;
+    conv_turns_to_deg_digit_arrays_avx2(digits, lowest_places, turns, bit_width, place);
+    for (i = 0; i < AVX2_LANES; i++) {
+        char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+        int lowest_place = lowest_places[i];
+        int k;
+        if (i > 0 || leading_separator) {
+            *buf++ = separator;
+        }
+        for (k = SERDES_TURN_DEG_MAX_PLACE; k >= lowest_place; k--) {
+            digit_array[BUF_INDEX(k)] = (char)digits[BUF_INDEX(k)][i];
+        }
+        if (kind != SERIALIZE_KIND_SHORTEST) {
+            carry_up_overflow(digit_array, lowest_place);
+            if (kind == SERIALIZE_KIND_PS) {
+                lowest_place = suppress_lower_zero(digit_array, lowest_place);
+            }
+        }
+        buf = conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+    }
+    return buf;
+}
+#endif
+
+
+/** Serialize an angle @ turn to the string of a kind.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+*/
+static char *conv_turn_to_deg_string_kind(char *buf, const unsigned int turn, const unsigned int bit_width, const int kind, const int place)
+{
+    switch (kind) {
+    case SERIALIZE_KIND_SHORTEST:
+        return conv_turn_to_deg_string(buf, turn, bit_width);
+    case SERIALIZE_KIND_P:
+        return conv_turn_to_deg_string_p(buf, turn, bit_width, place);
+    default:
+        assert(kind == SERIALIZE_KIND_PS);
+        return conv_turn_to_deg_string_ps(buf, turn, bit_width, place);
+    }
+}
+
+
+/** Serialize some angles @ turn to the strings separated by a character.
+    \param [inout] buf A buffer to write the serialized strings. The length must be at least SERDES_TURN_DEG_BATCH_BUF_SIZE(num).
+    \param [in] turns The angles @ turn.
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \param [in] separator The character to put between the serialized strings.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+
+    This function uses the table of the serialized strings if it's generated at build time, or serializes 8 angles at once by AVX2 if the compiler enables it and bit_width is not more than SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH.
+*/
+static char *conv_turns_to_deg_string(char *buf, const unsigned int *const turns, const size_t num, const unsigned int bit_width, const int kind, const int place, const char separator)
+{
+    size_t i = 0;
+#ifdef SERDES_TURN_DEG_USE_TABLE
+    const struct DegTable *const table = find_deg_table(bit_width, kind, place);
+#endif
+    STATS_ADD(serialized_by_bit_width[bit_width], num);
+    if (kind == SERIALIZE_KIND_SHORTEST) {
+        STATS_ADD(serialized_shortest, num);
+    } else {
+        STATS_ADD(serialized_by_precision[-place - SERDES_TURN_DEG_MIN_PRECISION], num);
+    }
+#ifdef SERDES_TURN_DEG_USE_TABLE
+    if (table != NULL) {
+        *buf = '\0';
+        for (i = 0; i < num; i++) {
+            if (i > 0) {
+                *buf++ = separator;
+            }
+            buf = copy_from_deg_table(buf, table, turns[i]);
+        }
+        return buf;
+    }
+#endif
+    *buf = '\0';
+#ifdef SERDES_TURN_DEG_USE_AVX2
+    if (bit_width <= SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        for (; i + AVX2_LANES <= num; i += AVX2_LANES) {
+            buf = conv_8_turns_to_deg_string_avx2(buf, turns + i, bit_width, kind, place, separator, i > 0);
+        }
+    }
+#endif
+    for (; i < num; i++) {
+        if (i > 0) {
+            *buf++ = separator;
+        }
+        buf = conv_turn_to_deg_string_kind(buf, turns[i], bit_width, kind, place);
+    }
+    return buf;
+}
+
+
+/** Serialize an angle @ turn to the string of a kind, and count it in the statistics.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUILD_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \return The point to NUL character in buf.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+
+    The functions for an angle use this instead of conv_turns_to_deg_string(), which sets up the batch for the array.
+*/
+static char *conv_turn_to_deg_string_single(char *buf, const unsigned int turn, const unsigned int bit_width, const int kind, const int place)
+{
+#ifdef SERDES_TURN_DEG_USE_TABLE
+    const struct DegTable *table;
+#endif
+    STATS_ADD(serialized_by_bit_width[bit_width], 1);
+    if (kind == SERIALIZE_KIND_SHORTEST) {
+        STATS_ADD(serialized_shortest, 1);
+    } else {
+        STATS_ADD(serialized_by_precision[-place - SERDES_TURN_DEG_MIN_PRECISION], 1);
+    }
+#ifdef SERDES_TURN_DEG_USE_TABLE
+    table = find_deg_table(bit_width, kind, place);
+    if (table != NULL) {
+        return copy_from_deg_table(buf, table, turn);
+    }
+#endif
+    return conv_turn_to_deg_string_kind(buf, turn, bit_width, kind, place);
+}
+
+
+/** Calculate the length of a serialized string without writing it.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \return The length of the serialized string without NUL.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+
+    This function finds the length from the digit array instead of converting it to the string.
+*/
+static size_t conv_turn_to_deg_length(const unsigned int turn, const unsigned int bit_width, const int kind, const int place)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    int lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, place);
+    int highest_place; /* the highest place of nonzero digit in the integer part, or 0 */
+
+    if (digit_array[BUF_INDEX(lowest_place)] == 10) {
+        /* The carry can change the upper digits, so follow it. It's impossible if kind is SERIALIZE_KIND_SHORTEST. */
+        int k = lowest_place;
+        do {
+            /* The digit is 0 after the carry. */
+            k++;
+            assert(k <= SERDES_TURN_DEG_MAX_PLACE);
+        } while (digit_array[BUF_INDEX(k)] + 1 == 10);
+        if (kind == SERIALIZE_KIND_PS && lowest_place < 0) {
+            lowest_place = k < 0 ? k : 0;
+        }
+        /* The digit at the place k is nonzero after the carry. */
+        highest_place = k > 0 ? k : 0;
+        for (k = k + 1; k <= SERDES_TURN_DEG_MAX_PLACE; k++) {
+            if (digit_array[BUF_INDEX(k)] != 0) {
+                highest_place = k;
+            }
+        }
+    } else {
+        highest_place = digit_array[BUF_INDEX(2)] != 0 ? 2 : (lowest_place <= 1 && digit_array[BUF_INDEX(1)] != 0) ? 1 : 0;
+        if (kind == SERIALIZE_KIND_PS) {
+            while (lowest_place < 0 && digit_array[BUF_INDEX(lowest_place)] == 0) {
+                lowest_place++;
+            }
+        }
+    }
+    /* The integer part, the decimal point, and the decimal places */
+    return (size_t)highest_place + 1 + (lowest_place < 0 ? (size_t)(1 - lowest_place) : 0);
+}
+
+
+/** Calculate the total length of the serialized strings separated by a character.
+    \param [in] turns The angles @ turn.
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns.
+    \param [in] kind SERIALIZE_KIND_*
+    \param [in] place The maximum place of digit to output. It must be SERDES_TURN_DEG_MAX_PLACE if kind is SERIALIZE_KIND_SHORTEST.
+    \return The length of the serialized strings and the separators without NUL.
+    \pre bit_width and place are in range. The caller is responsible for the check.
+
+    This function uses the offsets in the table of the serialized strings if it's generated at build time.
+*/
+static size_t conv_turns_to_deg_length(const unsigned int *const turns, const size_t num, const unsigned int bit_width, const int kind, const int place)
+{
+    size_t len = num > 0 ? num - 1 : 0; /* separators */
+    size_t i;
+#ifdef SERDES_TURN_DEG_USE_TABLE
+    const struct DegTable *const table = find_deg_table(bit_width, kind, place);
+    if (table != NULL) {
+        for (i = 0; i < num; i++) {
+            const unsigned int turn = turns[i] & TURN_MASK(table->bit_width);
+            len += table->offsets[turn + 1] - table->offsets[turn];
+        }
+        return len;
+    }
+#endif
+    for (i = 0; i < num; i++) {
+        len += conv_turn_to_deg_length(turns[i], bit_width, kind, place);
+    }
+    return len;
+}
+
+
+/** Find a character.
+    \param [in] ptr The beginning of the text.
+    \param [in] end The end of the text.
+    \param [in] c The character to find.
+    \return The pointer to the first c in [ptr, end), or end if c is not found.
+*/
+static const char *find_char(const char *ptr, const char *const end, const char c)
+{
+#if defined(SERDES_TURN_DEG_USE_AVX2)
+    const __m256i pattern = _mm256_set1_epi8(c);
+    for (; end - ptr >= 32; ptr += 32) {
+        const __m256i text = _mm256_loadu_si256((const __m256i *)ptr);
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(text, pattern));
+        if (mask != 0) {
+            return ptr + count_trailing_zeros(mask);
+        }
+    }
+#endif
+#if defined(SERDES_TURN_DEG_USE_SSE2)
+    {
+        const __m128i pattern16 = _mm_set1_epi8(c);
+        for (; end - ptr >= 16; ptr += 16) {
+            const __m128i text = _mm_loadu_si128((const __m128i *)ptr);
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(text, pattern16));
+            if (mask != 0) {
+                return ptr + count_trailing_zeros(mask);
+            }
+        }
+    }
+#endif
+    for (; ptr != end; ptr++) {
+        if (*ptr == c) {
+            break;
+        }
+    }
+    return ptr;
+}
+
+
+#ifndef SERDES_TURN_DEG_DEBUG_NO_SWAR
+/** Load the characters for SWAR.
+    \param [in] ptr The beginning of the text.
+    \param [in] end The end of the text, or NULL if the text is terminated by NUL.
+    \return SWAR_BYTES characters in little endian, where the characters from NUL or end are 0.
+*/
+static unsigned long swar_load(const char *const ptr, const char *const end)
+{
+    unsigned long x = 0;
+    size_t i;
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (end != NULL && end - ptr >= SWAR_BYTES) {
+        memcpy(&x, ptr, SWAR_BYTES);
+        return x;
+    }
+#endif
+    /* Don't read after the text. */
+    for (i = 0; i < SWAR_BYTES && ptr + i != end && ptr[i] != '\0'; i++) {
+        x |= (unsigned long)(unsigned char)ptr[i] << (8 * i);
+    }
+    return x;
+}
+
+/** Count the digits at the beginning of SWAR_BYTES characters.
+    \param [in] x The characters loaded by swar_load().
+    \return The number of the digits in [0, SWAR_BYTES].
+*/
+static size_t swar_count_digits(const unsigned long x)
+{
+    /* The top bit of a byte is set if the byte is more than '9', less than '0', or not ASCII. The carry and the borrow propagate to the upper bytes only from such a byte. */
+    unsigned long mask = ((x + SWAR_ONES * 0x46) | (x - SWAR_ONES * 0x30) | x) & SWAR_ONES * 0x80;
+    size_t n = 0;
+    if (mask == 0) {
+        return SWAR_BYTES;
+    }
+#if defined(__GNUC__)
+    n = (size_t)__builtin_ctzl(mask) / 8;
+#else
+    for (; (mask & 0x80) == 0; mask >>= 8) {
+        n++;
+    }
+#endif
+    return n;
+}
+#endif
+
+
+/** Count the digits at the beginning of the text.
+    \param [in] ptr The beginning of the text.
+    \param [in] end The end of the text, or NULL if the text is terminated by NUL.
+    \param [in] limit The maximum number to count.
+    \return The number of the digits, but not more than limit.
+*/
+static size_t count_digits(const char *const ptr, const char *const end, const size_t limit)
+{
+    size_t n = 0;
+#if defined(SERDES_TURN_DEG_USE_SSE2)
+    if (end != NULL) {
+        /* c is a digit if (unsigned char)(c - '0') <= 9. */
+        const __m128i zero_char = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i zero = _mm_setzero_si128();
+        while (n < limit && end - (ptr + n) >= 16) {
+            const __m128i text = _mm_loadu_si128((const __m128i *)(ptr + n));
+            const __m128i over = _mm_subs_epu8(_mm_sub_epi8(text, zero_char), nine);
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(over, zero)) ^ 0xFFFFu;
+            if (mask != 0) {
+                n += count_trailing_zeros(mask);
+                return n < limit ? n : limit;
+            }
+            n += 16;
+        }
+        if (n > limit) {
+            n = limit;
+        }
+    }
+#endif
+#ifndef SERDES_TURN_DEG_DEBUG_NO_SWAR
+    while (n < limit) {
+        const size_t m = swar_count_digits(swar_load(ptr + n, end));
+        n += m;
+        if (m < SWAR_BYTES) {
+            break;
+        }
+    }
+    return n < limit ? n : limit;
+#else
+    for (; n < limit && ptr + n != end && IS_DIGIT(ptr[n]); n++) {
+    }
+    return n;
+#endif
+}
+
+
+#ifdef SERDES_TURN_DEG_USE_SWAR
+/** Convert the digits at the beginning of 8 characters to the value.
+    \param [in] x 8 characters loaded by swar_load().
+    \param [in] n The number of the digits to convert. It must be in range [1, 8].
+    \return The value of the n digits.
+*/
+static unsigned long swar_digits_to_value(unsigned long x, const size_t n)
+{
+    assert(1 <= n && n <= 8);
+    /* The lower bytes after shift are 0, which are the leading 0 of the value. */
+    x = (x << (8 * (8 - n))) & 0x0F0F0F0F0F0F0F0Ful;
+    x = (x * (10 * 256 + 1)) >> 8; /* 2 digits in 16 bits */
+    x = ((x & 0x00FF00FF00FF00FFul) * (100 * 65536 + 1)) >> 16; /* 4 digits in 32 bits */
+    return ((x & 0x0000FFFF0000FFFFul) * ((10000ul << 32) + 1)) >> 32; /* 8 digits */
+}
+#endif
+
+
+/** Parse a series of digits.
+    \param [in] ptr The beginning of the digits.
+    \param [in] end The end of the text, or NULL if the text is terminated by NUL.
+    \param [in] count_limit The maximum number of the digits to count.
+    \param [in] convert_limit The maximum number of the digits to convert. It must be in range [0, -SERDES_TURN_DEG_MIN_PLACE].
+    \param [inout] value The value to append the converted digits.
+    \return The number of the digits, but not more than count_limit.
+
+    The first min(the number of the digits, convert_limit) digits are appended to value.
+*/
+static size_t parse_digits(const char *const ptr, const char *const end, const size_t count_limit, const size_t convert_limit, unsigned long *const value)
+{
+    size_t n;
+    size_t k;
+#ifdef SERDES_TURN_DEG_USE_SWAR
+    static const unsigned long pow10[] = { 1ul, 10ul, 100ul, 1000ul, 10000ul, 100000ul, 1000000ul, 10000000ul, 100000000ul };
+    const unsigned long x = swar_load(ptr, end);
+    assert(convert_limit < sizeof(pow10) / sizeof(pow10[0]));
+    n = swar_count_digits(x);
+    if (n == SWAR_BYTES && count_limit > SWAR_BYTES) {
+        n += count_digits(ptr + SWAR_BYTES, end, count_limit - SWAR_BYTES);
+    }
+    n = n < count_limit ? n : count_limit;
+    k = n < convert_limit ? n : convert_limit;
+    if (k > 0) {
+        *value = *value * pow10[k] + swar_digits_to_value(x, k);
+    }
+#else
+    n = count_digits(ptr, end, count_limit);
+    for (k = 0; k < n && k < convert_limit; k++) {
+        *value *= 10;
+        *value += ptr[k] - '0';
+    }
+#endif
+    return n;
+}
+
+
+/** The maximum number of the digits after the decimal point that the deserialization reads for bit_width.
+    The bit-width up to SERDES_TURN_DEG_MAX_BIT_WIDTH reads SERDES_TURN_DEG_MAX_PRECISION digits in any build, so the result doesn't depend on SERDES_TURN_DEG_WIDE.
+*/
+#define MAX_DECIMALS(bit_width) ((bit_width) <= SERDES_TURN_DEG_MAX_BIT_WIDTH ? (unsigned int)SERDES_TURN_DEG_MAX_PRECISION : (unsigned int)-SERDES_TURN_DEG_MIN_PLACE)
+
+/** Parse a text of a degree.
+    \param [in] ptr The beginning of the text.
+    \param [in] end The end of the text, or NULL if the text is terminated by NUL.
+    \param [in] max_decimals The maximum number of the digits to convert after the decimal point, which is MAX_DECIMALS(bit_width).
+    \param [out] deg The parsed degree multiplied by 10**decimals. The integer part is in range [0, 360).
+    \param [out] decimals The number of the parsed digits after the decimal point, which is in range [0, max_decimals].
+    \return The pointer to the next character of the last one that used the conversion.
+
+    This function accepts a text matched at the regexp "\s*[0-9]{0,2}(\.[0-9]*)?", but ignores the digits after max_decimals.
+    It converts 8 digits at once by SWAR if possible.
+*/
+static const char *parse_deg(const char *ptr, const char *const end, const unsigned int max_decimals, unsigned long *const deg, unsigned int *const decimals)
+{
+    const char *const begin = ptr;
+    size_t n;
+    size_t num_of_digits;
+    size_t i = 0;
+    unsigned long value = 0;
+
+    for (; ptr != end && *ptr != '\0'; ptr++) {
+        if (!isspace((unsigned char)*ptr)) {
+            break;
+        }
+    }
+    num_of_digits = parse_digits(ptr, end, SERDES_TURN_DEG_MAX_PLACE + 1, SERDES_TURN_DEG_MAX_PLACE + 1, &value);
+    ptr += num_of_digits;
+    value %= 360;
+
+    if (ptr != end && *ptr == '.') {
+        ptr++;
+        n = parse_digits(ptr, end, (size_t)-1, max_decimals, &value);
+        /* The digits after max_decimals are truncated. */
+        i = n < max_decimals ? n : max_decimals;
+        STATS_ADD(truncated_digits, n - i);
+        num_of_digits += n;
+        ptr += n;
+    }
+    STATS_ADD(parsed_length[STATS_BIN(ptr - begin, SERDES_TURN_DEG_STATS_NUM_OF_LEN_BINS)], 1);
+    STATS_ADD(no_digits, num_of_digits == 0);
+    *deg = value;
+    *decimals = (unsigned int)i;
+    return ptr;
+}
+
+
+#ifdef SERDES_TURN_DEG_USE_MAGIC_DIVISION
+/** The reciprocal of 180 * 10**decimals for conv_scaled_deg_to_turn(). */
+struct DegReciprocal {
+    unsigned long magic; /**< ceil(2**(64 + shift) / divisor), where divisor is the odd part 45 * 5**decimals. */
+    unsigned int shift; /**< The shift after taking the upper 64 bits of the product. */
+};
+
+/** The reciprocals for each number of the decimal places.
+
+    180 * 10**d is 2**(2 + d) * 45 * 5**d, so the division by it is the shift and the division by the odd part. The dividend of the odd part is less than 2**58, and magic and shift are the smallest ones that satisfy magic * divisor - 2**(64 + shift) <= 2**(64 + shift - 58) (Granlund and Montgomery, https://doi.org/10.1145/773473.178249), so the quotient is exact.
+*/
+static const struct DegReciprocal deg_reciprocals[-SERDES_TURN_DEG_MIN_PLACE + 1] = {
+    { 0x05B05B05B05B05B1ul, 0 },
+    { 0x048D159E26AF37C1ul, 2 },
+    { 0x07482296A44B8C67ul, 5 },
+    { 0x05D34EDEE9D609ECul, 7 },
+    { 0x04A90BE587DE6E57ul, 9 },
+    { 0x0774DFD5A630B08Bul, 12 },
+    { 0x05F71977B826F3A2ul, 14 },
+    { 0x04C5ADF9601F294Ful, 16 },
+    { 0x07A2AFF566984217ul, 19 },
+};
+
+/** The upper 64 bits of the product of 64-bit numbers.
+    \param [in] a A number less than 2**64.
+    \param [in] b A number less than 2**64.
+    \return (a * b) >> 64
+*/
+static unsigned long mul_high(const unsigned long a, const unsigned long b)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    return (unsigned long)(((uint128)a * b) >> 64);
+#else
+    const unsigned long a_low = a & 0xFFFFFFFFul;
+    const unsigned long a_high = a >> 32;
+    const unsigned long b_low = b & 0xFFFFFFFFul;
+    const unsigned long b_high = b >> 32;
+    const unsigned long low_low = a_low * b_low;
+    const unsigned long high_low = a_high * b_low;
+    const unsigned long low_high = a_low * b_high;
+    const unsigned long middle = (low_low >> 32) + (high_low & 0xFFFFFFFFul) + (low_high & 0xFFFFFFFFul);
+    return a_high * b_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+#endif
+}
+#else
+/** 180 * 10**decimals for conv_scaled_deg_to_turn(). */
+static const unsigned long deg_scales[-SERDES_TURN_DEG_MIN_PLACE + 1] = {
+    180ul, 1800ul, 18000ul, 180000ul, 1800000ul, 18000000ul,
+#ifdef SERDES_TURN_DEG_WIDE
+    180000000ul, 1800000000ul, 18000000000ul,
+#endif
+};
+#endif
+
+
+/** Convert an angle @ degree to @ turn.
+    \param [in] deg The angle @ degree multiplied by 10**decimals. It must be less than 360 * 10**decimals.
+    \param [in] decimals The number of the decimal places of deg. It must be in range [0, -SERDES_TURN_DEG_MIN_PLACE].
+    \param [in] bit_width The bit-width of the return value.
+    \return The angle @ turn.
+
+    The turn is deg * 2**bit_width / (180 * 10**decimals) / 2 rounded half up. No hardware division is used.
+*/
+static unsigned int conv_scaled_deg_to_turn(const unsigned long deg, const unsigned int decimals, const unsigned int bit_width)
+{
+    assert(decimals <= (unsigned int)-SERDES_TURN_DEG_MIN_PLACE);
+    STATS_ADD(deserialized_by_bit_width[bit_width], 1);
+#ifdef SERDES_TURN_DEG_USE_MAGIC_DIVISION
+    {
+        /* deg * 2**bit_width / 2**(2 + decimals) as the dividend of the odd part. deg < 2 * 180 * 10**decimals, so it's less than 2 * 45 * 5**8 * 2**32 < 2**58. */
+        const unsigned int power_of_2 = 2 + decimals;
+        const unsigned long R = bit_width >= power_of_2 ? deg << (bit_width - power_of_2) : deg >> (power_of_2 - bit_width);
+        const struct DegReciprocal *const reciprocal = &deg_reciprocals[decimals];
+        unsigned long turn = mul_high(R, reciprocal->magic) >> reciprocal->shift; /* 2 * turn before rounding */
+        turn = turn / 2 + (turn & 1);
+        return (unsigned int)turn & TURN_MASK(bit_width);
+    }
+#else
+    /* A variation of (FPP)2 in dragon4 (https://dl.acm.org/doi/10.1145/93548.93559). */
+    {
+        const unsigned long S = deg_scales[decimals];
+        unsigned long R = deg;
+        unsigned int turn = 0;
+        unsigned int i;
+        for (i = 0; i <= bit_width; i++) {
+            /* R < 2 * S, so the quotient is 0 or 1. */
+            const unsigned int U = R >= S;
+            R -= U ? S : 0;
+            R <<= 1;
+            turn <<= 1;
+            turn |= U;
+        }
+        if (turn & 1) {
+            turn = (turn / 2) + 1;
+        } else {
+            turn = turn / 2;
+        }
+        turn &= TURN_MASK(bit_width);
+        return turn;
+    }
+#endif
+}
+
+
+/** Check the text that parse_deg() parsed.
+    \param [in] begin The beginning of the text.
+    \param [in] ptr The return value of parse_deg().
+    \param [in] end The end of the text.
+    \return SERDES_TURN_DEG_SUCCESS, SERDES_TURN_DEG_ERR_NO_DIGITS, or SERDES_TURN_DEG_ERR_OUT_OF_RANGE as same as deserialize_turn_from_deg_n().
+*/
+static int check_parsed_deg(const char *const begin, const char *const ptr, const char *const end)
+{
+    /* The converted text is "\s*[0-9]*(\.[0-9]*)?", so it has a digit if it ends with a digit except the decimal point. */
+    const char *last = ptr;
+    if (last != begin && last[-1] == '.') {
+        last--;
+    }
+    if (last == begin || !IS_DIGIT(last[-1])) {
+        return SERDES_TURN_DEG_ERR_NO_DIGITS;
+    }
+    if (ptr != end && IS_DIGIT(*ptr)) {
+        return SERDES_TURN_DEG_ERR_OUT_OF_RANGE;
+    }
+    return SERDES_TURN_DEG_SUCCESS;
+}
+
+
+/** Deserialize some degrees separated by a character.
+    \param [in] ptr The beginning of the degrees.
+    \param [in] end The end of the degrees.
+    \param [in] separator The character between the degrees.
+    \param [in] bit_width The bit-width of turns.
+    \param [out] turns The angles @ turn. The length must be at least max_num.
+    \param [in] max_num The maximum number of the degrees to deserialize.
+    \param [out] endptrs The same as deserialize_turns_from_deg().
+    \param [out] next The same as deserialize_turns_from_deg().
+    \return The number of the deserialized degrees.
+    \pre bit_width is in range. The caller is responsible for the check.
+*/
+static size_t conv_deg_strings_to_turns(const char *ptr, const char *const end, const char separator, const unsigned int bit_width, unsigned int *const turns, const size_t max_num, const char **const endptrs, const char **const next)
+{
+    size_t i;
+    for (i = 0; i < max_num && ptr != end; i++) {
+        const char *const field_end = find_char(ptr, end, separator);
+        unsigned long deg;
+        unsigned int decimals;
+        const char *const endptr = parse_deg(ptr, field_end, MAX_DECIMALS(bit_width), &deg, &decimals);
+        turns[i] = conv_scaled_deg_to_turn(deg, decimals, bit_width);
+        if (endptrs != NULL) {
+            endptrs[i] = endptr;
+        }
+        ptr = field_end;
+        if (ptr != end) {
+            /* skip the separator */
+            ptr++;
+        }
+    }
+    if (next != NULL) {
+        *next = ptr;
+    }
+    return i;
+}
+
+
+/** The state of a streaming parser: the white spaces before the degree. */
+#define PARSER_STATE_SPACE 0
+/** The state of a streaming parser: the integer part. */
+#define PARSER_STATE_INTEGER 1
+/** The state of a streaming parser: the digits after the decimal point. */
+#define PARSER_STATE_FRACTION 2
+/** The state of a streaming parser: the characters after the degree, which are ignored until the separator. */
+#define PARSER_STATE_TAIL 3
+
+/** Reset a streaming parser for the next field. */
+static void reset_parser_field(struct serdes_turn_deg_parser *const parser)
+{
+    parser->state = PARSER_STATE_SPACE;
+    parser->result = SERDES_TURN_DEG_SUCCESS;
+    parser->deg = 0;
+    parser->count = 0;
+    parser->decimals = 0;
+    parser->length = 0;
+}
+
+/** Parse a character of a field across the chunks as same as parse_deg().
+    \param [inout] parser The state of the parser.
+    \param [in] c The character, which isn't the separator.
+*/
+static void parse_deg_char(struct serdes_turn_deg_parser *const parser, const char c)
+{
+    const int is_digit = IS_DIGIT(c);
+    if (parser->state == PARSER_STATE_SPACE) {
+        if (isspace((unsigned char)c)) {
+            parser->length++;
+            return;
+        }
+        parser->state = PARSER_STATE_INTEGER;
+    }
+    if (parser->state == PARSER_STATE_INTEGER) {
+        if (is_digit && parser->count < SERDES_TURN_DEG_MAX_PLACE + 1) {
+            parser->deg = parser->deg * 10 + (unsigned int)(c - '0');
+            parser->count++;
+            parser->length++;
+            return;
+        }
+        if (c == '.') {
+            parser->deg %= 360;
+            parser->state = PARSER_STATE_FRACTION;
+            parser->length++;
+            return;
+        }
+        parser->result = is_digit ? SERDES_TURN_DEG_ERR_OUT_OF_RANGE : parser->count == 0 ? SERDES_TURN_DEG_ERR_NO_DIGITS : SERDES_TURN_DEG_ERR_INVALID_CHAR;
+        parser->state = PARSER_STATE_TAIL;
+    } else if (parser->state == PARSER_STATE_FRACTION) {
+        if (is_digit) {
+            if (parser->decimals < MAX_DECIMALS(parser->bit_width)) {
+                parser->deg = parser->deg * 10 + (unsigned int)(c - '0');
+                parser->decimals++;
+            } else {
+                /* The digits after MAX_DECIMALS() are truncated. */
+                STATS_ADD(truncated_digits, 1);
+            }
+            parser->count++;
+            parser->length++;
+            return;
+        }
+        parser->result = parser->count == 0 ? SERDES_TURN_DEG_ERR_NO_DIGITS : SERDES_TURN_DEG_ERR_INVALID_CHAR;
+        parser->state = PARSER_STATE_TAIL;
+    }
+}
+
+/** Deserialize the field across the chunks and call the callback.
+    \param [inout] parser The state of the parser, which is reset for the next field.
+*/
+static void finish_parser_field(struct serdes_turn_deg_parser *const parser)
+{
+    int result = parser->result;
+    if (parser->state != PARSER_STATE_TAIL) {
+        result = parser->count == 0 ? SERDES_TURN_DEG_ERR_NO_DIGITS : SERDES_TURN_DEG_SUCCESS;
+    }
+    if (parser->decimals == 0) {
+        /* The integer part without the decimal point isn't reduced yet. */
+        parser->deg %= 360;
+    }
+    STATS_ADD(parsed_length[STATS_BIN(parser->length, SERDES_TURN_DEG_STATS_NUM_OF_LEN_BINS)], 1);
+    STATS_ADD(no_digits, parser->count == 0);
+    parser->callback(parser->context, conv_scaled_deg_to_turn(parser->deg, parser->decimals, parser->bit_width), result);
+    reset_parser_field(parser);
+}
+
+
+/** The minimum number of the angles that a task of serialize_turns_to_deg_parallel() serializes. */
+#define PARALLEL_MIN_TURNS_PER_TASK 4096
+/** The minimum number of the characters that a task of deserialize_turns_from_deg_parallel() deserializes. */
+#define PARALLEL_MIN_CHARS_PER_TASK 32768
+
+/** Limit the number of the tasks not to make tiny tasks.
+    \param [in] num_of_tasks The number of the tasks that the caller wants.
+    \param [in] size The size of the whole work.
+    \param [in] min_size_per_task The minimum size of the work for a task.
+    \return The number of the tasks in range [1, num_of_tasks].
+*/
+static size_t limit_num_of_tasks(const size_t num_of_tasks, const size_t size, const size_t min_size_per_task)
+{
+    const size_t max_num_of_tasks = size / min_size_per_task;
+    return max_num_of_tasks < 1 ? 1 : max_num_of_tasks < num_of_tasks ? max_num_of_tasks : num_of_tasks;
+}
+
+/** The beginning of the range of a task when num items are split into num_of_tasks ranges evenly.
+    \param [in] num The number of the items.
+    \param [in] num_of_tasks The number of the tasks.
+    \param [in] index The index of the task in range [0, num_of_tasks].
+    \return The index of the first item of the task, or num if index is num_of_tasks.
+*/
+static size_t task_begin(const size_t num, const size_t num_of_tasks, const size_t index)
+{
+    const size_t remainder = num % num_of_tasks;
+    return num / num_of_tasks * index + (index < remainder ? index : remainder);
+}
+
+#ifdef SERDES_TURN_DEG_PTHREAD
+/** A task to run on a thread. */
+struct ThreadTask {
+    serdes_turn_deg_task task; /**< The function of the task. */
+    void *task_arg; /**< The argument of the task. */
+    size_t index; /**< The index of the task. */
+};
+
+/** The entry point of a thread. */
+static void *run_thread_task(void *arg)
+{
+    const struct ThreadTask *const thread_task = (const struct ThreadTask *)arg;
+    thread_task->task(thread_task->task_arg, thread_task->index);
+    return NULL;
+}
+#endif
+
+/** Run the tasks of a parallel batch function.
+    \param [in] num_of_tasks The number of the tasks in range [1, SERDES_TURN_DEG_MAX_TASKS].
+    \param [in] task The function of the tasks.
+    \param [in] task_arg The argument of the tasks.
+    \param [in] executor The executor that the caller gives, or NULL.
+    \param [in] context The context of executor.
+
+    If executor is NULL, the tasks run on the threads that this function creates if the library is built with SERDES_TURN_DEG_PTHREAD, or on the calling thread one after another.
+*/
+static void run_tasks(const size_t num_of_tasks, const serdes_turn_deg_task task, void *const task_arg, const serdes_turn_deg_executor executor, void *const context)
+{
+    size_t i;
+    assert(1 <= num_of_tasks && num_of_tasks <= SERDES_TURN_DEG_MAX_TASKS);
+    if (num_of_tasks == 1) {
+        task(task_arg, 0);
+    } else if (executor != NULL) {
+        executor(context, num_of_tasks, task, task_arg);
+    } else {
+#ifdef SERDES_TURN_DEG_PTHREAD
+        pthread_t threads[SERDES_TURN_DEG_MAX_TASKS];
+        struct ThreadTask thread_tasks[SERDES_TURN_DEG_MAX_TASKS];
+        int started[SERDES_TURN_DEG_MAX_TASKS];
+        /* The calling thread runs the task 0, and the task that failed to start a thread. */
+        for (i = 1; i < num_of_tasks; i++) {
+            thread_tasks[i].task = task;
+            thread_tasks[i].task_arg = task_arg;
+            thread_tasks[i].index = i;
+            started[i] = pthread_create(&threads[i], NULL, run_thread_task, &thread_tasks[i]) == 0;
+        }
+        task(task_arg, 0);
+        for (i = 1; i < num_of_tasks; i++) {
+            if (started[i]) {
+                pthread_join(threads[i], NULL);
+            } else {
+                task(task_arg, i);
+            }
+        }
+#else
+        for (i = 0; i < num_of_tasks; i++) {
+            task(task_arg, i);
+        }
+#endif
+    }
+}
+
+/** The work of serialize_turns_to_deg_parallel(). */
+struct ParallelSerialization {
+    char *buf; /**< The buffer to write the strings. */
+    const unsigned int *turns; /**< The angles. */
+    size_t num; /**< The number of the angles. */
+    unsigned int bit_width; /**< The bit-width of the angles. */
+    int kind; /**< SERIALIZE_KIND_* */
+    int place; /**< The maximum place of digit to output. */
+    char separator; /**< The character between the strings. */
+    size_t num_of_tasks; /**< The number of the tasks. */
+    size_t stride; /**< The buffer length for an angle: SERDES_TURN_DEG_BUF_SIZE, or SERDES_TURN_DEG_WIDE_BUF_SIZE for the wide bit-width or precision. */
+    size_t lengths[SERDES_TURN_DEG_MAX_TASKS]; /**< The length of the strings that each task writes. */
+};
+
+/** Serialize the angles of a task into its own region of the buffer.
+
+    The task serializes the angles [begin, end) to buf + begin * stride. The strings and the separators are at most (end - begin) * stride - 1 characters, so the region doesn't overlap the next one even with NUL.
+*/
+static void serialize_task(void *const arg, const size_t index)
+{
+    struct ParallelSerialization *const work = (struct ParallelSerialization *)arg;
+    const size_t begin = task_begin(work->num, work->num_of_tasks, index);
+    const size_t end = task_begin(work->num, work->num_of_tasks, index + 1);
+    char *const region = work->buf + begin * work->stride;
+    work->lengths[index] = (size_t)(conv_turns_to_deg_string(region, work->turns + begin, end - begin, work->bit_width, work->kind, work->place, work->separator) - region);
+}
+
+/** Serialize the angles by the tasks, and concatenate the regions of the tasks in order.
+    \param [inout] work The work whose members except lengths are set.
+    \return The point to NUL character in the buffer.
+*/
+static char *conv_turns_to_deg_string_parallel(struct ParallelSerialization *const work, const serdes_turn_deg_executor executor, void *const context)
+{
+    char *ptr;
+    size_t i;
+
+    run_tasks(work->num_of_tasks, serialize_task, work, executor, context);
+    /* The region of the task i begins at the prefix sum of the lengths and the separators of the previous tasks, which is never after the original region. */
+    ptr = work->buf + work->lengths[0];
+    for (i = 1; i < work->num_of_tasks; i++) {
+        *ptr++ = work->separator;
+        memmove(ptr, work->buf + task_begin(work->num, work->num_of_tasks, i) * work->stride, work->lengths[i]);
+        ptr += work->lengths[i];
+    }
+    *ptr = '\0';
+    return ptr;
+}
+
+/** The work of deserialize_turns_from_deg_parallel(). */
+struct ParallelDeserialization {
+    const char *bounds[SERDES_TURN_DEG_MAX_TASKS + 1]; /**< The beginning of the text of each task, and the end of the whole text. */
+    size_t offsets[SERDES_TURN_DEG_MAX_TASKS + 1]; /**< The number of the fields before each task, and the number of all fields. */
+    size_t nums[SERDES_TURN_DEG_MAX_TASKS]; /**< The number of the fields that each task deserializes. */
+    const char *nexts[SERDES_TURN_DEG_MAX_TASKS]; /**< The pointer to the first field that each task doesn't deserialize. */
+    char separator; /**< The character between the fields. */
+    unsigned int bit_width; /**< The bit-width of turns. */
+    unsigned int *turns; /**< The angles. */
+    const char **endptrs; /**< The end pointers, or NULL. */
+    size_t num_of_tasks; /**< The number of the tasks. */
+};
+
+/** Count the fields in the text of a task. */
+static void count_fields_task(void *const arg, const size_t index)
+{
+    struct ParallelDeserialization *const work = (struct ParallelDeserialization *)arg;
+    const char *ptr = work->bounds[index];
+    const char *const end = work->bounds[index + 1];
+    size_t num = 0;
+    /* Each field starts at the beginning or after a separator, except at the end. */
+    while (ptr != end) {
+        ptr = find_char(ptr, end, work->separator);
+        num++;
+        if (ptr != end) {
+            ptr++;
+        }
+    }
+    work->nums[index] = num;
+}
+
+/** Deserialize the fields in the text of a task into turns from its offset. */
+static void deserialize_task(void *const arg, const size_t index)
+{
+    struct ParallelDeserialization *const work = (struct ParallelDeserialization *)arg;
+    const size_t offset = work->offsets[index];
+    (void)conv_deg_strings_to_turns(work->bounds[index], work->bounds[index + 1], work->separator, work->bit_width, work->turns + offset, work->nums[index], work->endptrs != NULL ? work->endptrs + offset : NULL, &work->nexts[index]);
+}
+
+
+/* external functions */
+
+char *serialize_turn_to_deg(char *buf, const unsigned int turn, unsigned int bit_width)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    return conv_turn_to_deg_string_single(buf, turn, bit_width, SERIALIZE_KIND_SHORTEST, SERDES_TURN_DEG_MAX_PLACE);
+}
+
+
+char *serialize_turn_to_deg_p(char *buf, const unsigned int turn, unsigned int bit_width, int precision)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return conv_turn_to_deg_string_single(buf, turn, bit_width, SERIALIZE_KIND_P, -precision);
+}
+
+
+char *serialize_turn_to_deg_ps(char *buf, const unsigned int turn, unsigned int bit_width, int precision)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return conv_turn_to_deg_string_single(buf, turn, bit_width, SERIALIZE_KIND_PS, -precision);
+}
+
+
+char *serialize_turns_to_deg(char *buf, const unsigned int *const turns, const size_t num, unsigned int bit_width, const char separator)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    return conv_turns_to_deg_string(buf, turns, num, bit_width, SERIALIZE_KIND_SHORTEST, SERDES_TURN_DEG_MAX_PLACE, separator);
+}
+
+
+char *serialize_turns_to_deg_p(char *buf, const unsigned int *const turns, const size_t num, unsigned int bit_width, int precision, const char separator)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return conv_turns_to_deg_string(buf, turns, num, bit_width, SERIALIZE_KIND_P, -precision, separator);
+}
+
+
+char *serialize_turns_to_deg_ps(char *buf, const unsigned int *const turns, const size_t num, unsigned int bit_width, int precision, const char separator)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return conv_turns_to_deg_string(buf, turns, num, bit_width, SERIALIZE_KIND_PS, -precision, separator);
+}
+
+int deg_fixed_min_precision(unsigned int bit_width)
+{
+    unsigned long S;
+    unsigned long M2 = 360; /* 2M at the place#2 */
+    int precision = SERDES_TURN_DEG_MIN_PRECISION;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    S = (1ul << bit_width) * 100; /* 100 degree */
+
+    /* If 2M > S at the lowest place, low or high is always true in conv_turn_to_deg_digit_array(). */
+    while (M2 <= S) {
+        M2 *= 10;
+        precision++;
+    }
+    assert(precision <= SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    return precision;
+}
+
+
+char *serialize_turn_to_deg_fixed(char *buf, const unsigned int turn, unsigned int bit_width, int precision, const char pad)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    char *dest = buf;
+    int leading = 1; /* only 0 in the upper places */
+    int min_precision;
+    int lowest_place;
+    int k;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    min_precision = deg_fixed_min_precision(bit_width);
+    if (precision < min_precision || precision > SERDES_TURN_DEG_BUILD_MAX_PRECISION) {
+        /* Raising precision would overflow buf sized by the caller's precision. */
+        return NULL;
+    }
+
+    STATS_ADD(serialized_by_bit_width[bit_width], 1);
+    STATS_ADD(serialized_by_precision[precision - SERDES_TURN_DEG_MIN_PRECISION], 1);
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, -precision);
+    assert(lowest_place == -precision);
+    carry_up_overflow(digit_array, lowest_place);
+    for (k = SERDES_TURN_DEG_MAX_PLACE; k >= lowest_place || k >= 0; k--) {
+        /* The places lower than lowest_place in the integer part are 0. */
+        const int digit = k >= lowest_place ? digit_array[BUF_INDEX(k)] : 0;
+        if (leading && k > 0 && digit == 0) {
+            *dest++ = pad;
+            continue;
+        }
+        leading = 0;
+        if (k == -1) {
+            *dest++ = '.';
+        }
+        *dest++ = '0' + digit;
+    }
+    *dest = '\0';
+    assert(dest - buf == SERDES_TURN_DEG_FIXED_WIDTH(precision));
+    STATS_ADD(serialized_length[dest - buf], 1);
+    return dest;
+}
+
+
+size_t serialize_turn_to_deg_bcd(unsigned char *const buf, const unsigned int turn, unsigned int bit_width)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    int lowest_place;
+    int highest_place = SERDES_TURN_DEG_MAX_PLACE;
+    int num_of_digits;
+    int i;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    STATS_ADD(serialized_by_bit_width[bit_width], 1);
+    STATS_ADD(serialized_shortest, 1);
+
+    /* The shortest digits need no carry. */
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, SERDES_TURN_DEG_MAX_PLACE);
+    while (highest_place > lowest_place && digit_array[BUF_INDEX(highest_place)] == 0) {
+        highest_place--;
+    }
+    num_of_digits = highest_place - lowest_place + 1;
+    buf[0] = (unsigned char)(((lowest_place + SERDES_TURN_DEG_BCD_PLACE_BIAS) << 4) | num_of_digits);
+    for (i = 0; i < num_of_digits; i += 2) {
+        const unsigned int high = (unsigned int)digit_array[BUF_INDEX(highest_place - i)];
+        const unsigned int low = i + 1 < num_of_digits ? (unsigned int)digit_array[BUF_INDEX(highest_place - i - 1)] : 0;
+        buf[1 + i / 2] = (unsigned char)((high << 4) | low);
+    }
+    return 1 + ((size_t)num_of_digits + 1) / 2;
+}
+
+
+size_t serialize_turn_to_deg_length(const unsigned int turn, unsigned int bit_width, const enum serdes_turn_deg_mode mode, int precision)
+{
+    return serialize_turns_to_deg_length(&turn, 1, bit_width, mode, precision);
+}
+
+
+size_t serialize_turns_to_deg_length(const unsigned int *const turns, const size_t num, unsigned int bit_width, const enum serdes_turn_deg_mode mode, int precision)
+{
+    assert(mode == SERDES_TURN_DEG_MODE_SHORTEST || mode == SERDES_TURN_DEG_MODE_P || mode == SERDES_TURN_DEG_MODE_PS);
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    if (mode == SERDES_TURN_DEG_MODE_P || mode == SERDES_TURN_DEG_MODE_PS) {
+        PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+        return conv_turns_to_deg_length(turns, num, bit_width, mode, -precision);
+    }
+    return conv_turns_to_deg_length(turns, num, bit_width, SERIALIZE_KIND_SHORTEST, SERDES_TURN_DEG_MAX_PLACE);
+}
+
+
+unsigned long conv_turn_to_deg_decimal(const unsigned int turn, unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision, int *const exponent)
+{
+    char digit_array[SERDES_TURN_DEG_BUILD_BUF_SIZE];
+    unsigned long mantissa = 0;
+    int lowest_place;
+    int k;
+
+    assert(mode == SERDES_TURN_DEG_MODE_SHORTEST || mode == SERDES_TURN_DEG_MODE_P || mode == SERDES_TURN_DEG_MODE_PS);
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    lowest_place = conv_turn_to_deg_digit_array(digit_array, turn, bit_width, mode_to_place(mode, precision));
+    if (mode != SERDES_TURN_DEG_MODE_SHORTEST) {
+        carry_up_overflow(digit_array, lowest_place);
+        if (mode == SERDES_TURN_DEG_MODE_PS) {
+            lowest_place = suppress_lower_zero(digit_array, lowest_place);
+        }
+    }
+    /* The places lower than lowest_place in the integer part are 0 as the string. */
+    for (k = SERDES_TURN_DEG_MAX_PLACE; k >= lowest_place || k >= 0; k--) {
+        mantissa = mantissa * 10 + (unsigned long)(k >= lowest_place ? digit_array[BUF_INDEX(k)] : 0);
+    }
+    *exponent = lowest_place < 0 ? lowest_place : 0;
+    return mantissa;
+}
+
+
+char *serialize_turns_to_deg_parallel(char *buf, const unsigned int *const turns, const size_t num, unsigned int bit_width, const enum serdes_turn_deg_mode mode, int precision, const char separator, size_t num_of_tasks, const serdes_turn_deg_executor executor, void *const context)
+{
+    struct ParallelSerialization work;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    if (mode != SERDES_TURN_DEG_MODE_SHORTEST) {
+        PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+    }
+    PARAM_CHECK(num_of_tasks, 1, SERDES_TURN_DEG_MAX_TASKS);
+    if (num == 0) {
+        *buf = '\0';
+        return buf;
+    }
+    work.buf = buf;
+    work.turns = turns;
+    work.num = num;
+    work.bit_width = bit_width;
+    work.kind = mode;
+    work.place = mode == SERDES_TURN_DEG_MODE_SHORTEST ? SERDES_TURN_DEG_MAX_PLACE : -precision;
+    work.separator = separator;
+    work.num_of_tasks = limit_num_of_tasks(num_of_tasks, num, PARALLEL_MIN_TURNS_PER_TASK);
+    if (bit_width > SERDES_TURN_DEG_MAX_BIT_WIDTH || -work.place > SERDES_TURN_DEG_MAX_PRECISION) {
+        work.stride = SERDES_TURN_DEG_WIDE_BUF_SIZE;
+    } else {
+        work.stride = SERDES_TURN_DEG_BUF_SIZE;
+    }
+    return conv_turns_to_deg_string_parallel(&work, executor, context);
+}
+
+
+void init_turn_to_deg_serializer(struct serdes_turn_deg_serializer *const serializer, unsigned int bit_width, const enum serdes_turn_deg_mode mode, int precision)
+{
+    assert(serializer != NULL);
+    assert(mode == SERDES_TURN_DEG_MODE_SHORTEST || mode == SERDES_TURN_DEG_MODE_P || mode == SERDES_TURN_DEG_MODE_PS);
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    memset(serializer, 0, sizeof(*serializer));
+    serializer->bit_width = bit_width;
+    if (mode == SERDES_TURN_DEG_MODE_P || mode == SERDES_TURN_DEG_MODE_PS) {
+        PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+        serializer->mode = mode;
+        serializer->place = -precision;
+    } else {
+        serializer->mode = SERDES_TURN_DEG_MODE_SHORTEST;
+        serializer->place = SERDES_TURN_DEG_MAX_PLACE;
+    }
+    serializer->lowest_place = SERDES_TURN_DEG_MAX_PLACE + 1; /* no previous angle */
+}
+
+
+char *serialize_turn_to_deg_incremental(struct serdes_turn_deg_serializer *const serializer, char *buf, const unsigned int turn)
+{
+    char *const digit_array = buf + 1;
+    int lowest_place;
+
+    assert(serializer != NULL);
+    assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= serializer->bit_width && serializer->bit_width <= SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    if (serializer->bit_width > SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        /* The remainders can overflow in unsigned int. */
+        return conv_turn_to_deg_string_single(buf, turn, serializer->bit_width, serializer->mode, serializer->place);
+    }
+
+    STATS_ADD(serialized_by_bit_width[serializer->bit_width], 1);
+    if (serializer->mode == SERDES_TURN_DEG_MODE_SHORTEST) {
+        STATS_ADD(serialized_shortest, 1);
+    } else {
+        STATS_ADD(serialized_by_precision[-serializer->place - SERDES_TURN_DEG_MIN_PRECISION], 1);
+    }
+    lowest_place = conv_turn_to_deg_digit_array_incremental(serializer, digit_array, turn);
+    if (serializer->mode != SERDES_TURN_DEG_MODE_SHORTEST) {
+        carry_up_overflow(digit_array, lowest_place);
+    }
+    if (serializer->mode == SERDES_TURN_DEG_MODE_PS) {
+        lowest_place = suppress_lower_zero(digit_array, lowest_place);
+    }
+    return conv_deg_digit_array_to_string(buf, digit_array, lowest_place);
+}
+
+
+void serialize_turn_to_deg_multi(const unsigned int turn, unsigned int bit_width, struct serdes_turn_deg_output *const outputs, const size_t num)
+{
+    int place = SERDES_TURN_DEG_MAX_PLACE;
+    size_t i;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    if (bit_width > SERDES_TURN_DEG_NARROW_MAX_BIT_WIDTH) {
+        /* The digits in unsigned long are generated for each output. */
+        for (i = 0; i < num; i++) {
+            outputs[i].end = conv_turn_to_deg_string_single(outputs[i].buf, turn, bit_width, outputs[i].mode, mode_to_place(outputs[i].mode, outputs[i].precision));
+        }
+        return;
+    }
+    for (i = 0; i < num; i++) {
+        const int output_place = mode_to_place(outputs[i].mode, outputs[i].precision);
+        if (output_place < place) {
+            place = output_place;
+        }
+    }
+    conv_turn_to_deg_strings_multi(turn, bit_width, outputs, num, place);
+}
+
+
+unsigned int deserialize_turn_from_deg(const char *const serialized_deg, const unsigned int bit_width, const char **const endptr)
+{
+    unsigned long deg;
+    unsigned int decimals;
+    const char *const ptr = parse_deg(serialized_deg, NULL, MAX_DECIMALS(bit_width), &deg, &decimals);
+    if (endptr != NULL) {
+        *endptr = ptr;
+    }
+    return conv_scaled_deg_to_turn(deg, decimals, bit_width);
+}
+
+
+int deserialize_turn_from_deg_n(const char *const serialized_deg, const size_t len, unsigned int bit_width, unsigned int *const turn, size_t *const consumed)
+{
+    const char *const end = serialized_deg + len;
+    const char *ptr = serialized_deg;
+    unsigned long deg;
+    unsigned int decimals;
+    int result;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    if (len > 0) {
+        /* parse_deg() treats end == NULL as the text terminated by NUL. */
+        ptr = parse_deg(serialized_deg, end, MAX_DECIMALS(bit_width), &deg, &decimals);
+    }
+    if (consumed != NULL) {
+        *consumed = ptr - serialized_deg;
+    }
+    result = check_parsed_deg(serialized_deg, ptr, end);
+    if (result == SERDES_TURN_DEG_SUCCESS) {
+        *turn = conv_scaled_deg_to_turn(deg, decimals, bit_width);
+    }
+    return result;
+}
+
+
+unsigned int deserialize_turn_from_deg_fixed(const char *const serialized_deg, unsigned int bit_width, int precision)
+{
+    const unsigned char *const p = (const unsigned char *)serialized_deg;
+    unsigned long deg;
+    int decimals;
+    int i;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(precision, SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_BUILD_MAX_PRECISION);
+
+    /* The digits after MAX_DECIMALS() are truncated as same as the text. */
+    decimals = precision < (int)MAX_DECIMALS(bit_width) ? precision : (int)MAX_DECIMALS(bit_width);
+    if (decimals < 0) {
+        decimals = 0;
+    }
+    /* ' ' & 0x0F and '0' & 0x0F are 0. */
+    deg = ((p[0] & 0x0Fu) * 100 + (p[1] & 0x0Fu) * 10 + (p[2] & 0x0Fu)) % 360;
+    /* p[3] is the decimal point. */
+    for (i = 0; i < decimals; i++) {
+        deg = deg * 10 + (p[4 + i] & 0x0Fu);
+    }
+    return conv_scaled_deg_to_turn(deg, (unsigned int)decimals, bit_width);
+}
+
+
+int deserialize_turn_from_deg_bcd(const unsigned char *const bcd, const size_t len, unsigned int bit_width, unsigned int *const turn, size_t *const consumed)
+{
+    int lowest_place;
+    int num_of_digits;
+    int highest_place;
+    size_t bcd_len;
+    unsigned long deg = 0;
+    unsigned int decimals = 0;
+    int min_place;
+    int k;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    min_place = -(int)MAX_DECIMALS(bit_width);
+
+    if (len == 0) {
+        return SERDES_TURN_DEG_ERR_NO_DIGITS;
+    }
+    lowest_place = (int)(bcd[0] >> 4) - SERDES_TURN_DEG_BCD_PLACE_BIAS;
+    num_of_digits = bcd[0] & 0x0F;
+    highest_place = lowest_place + num_of_digits - 1;
+    bcd_len = 1 + ((size_t)num_of_digits + 1) / 2;
+    if (num_of_digits == 0 || len < bcd_len) {
+        return SERDES_TURN_DEG_ERR_NO_DIGITS;
+    }
+    if (highest_place > SERDES_TURN_DEG_MAX_PLACE) {
+        return SERDES_TURN_DEG_ERR_OUT_OF_RANGE;
+    }
+    for (k = highest_place; k >= lowest_place; k--) {
+        const int index = highest_place - k;
+        const unsigned int digit = (bcd[1 + index / 2] >> (index % 2 ? 0 : 4)) & 0x0Fu;
+        if (digit > 9) {
+            return SERDES_TURN_DEG_ERR_OUT_OF_RANGE;
+        }
+        if (k < min_place) {
+            /* truncated as same as the text */
+            continue;
+        }
+        deg = deg * 10 + digit;
+        if (k == 0) {
+            /* The integer part is taken modulo 360 as same as the text. */
+            deg %= 360;
+        }
+    }
+    if (lowest_place > 0) {
+        /* The lower places of the integer part are 0. */
+        for (k = lowest_place; k > 0; k--) {
+            deg *= 10;
+        }
+        deg %= 360;
+    }
+    /* The suppressed zeros after the decimal point count, too. */
+    if (lowest_place < 0) {
+        decimals = (unsigned int)-(lowest_place < min_place ? min_place : lowest_place);
+    }
+    *turn = conv_scaled_deg_to_turn(deg, decimals, bit_width);
+    if (consumed != NULL) {
+        *consumed = bcd_len;
+    }
+    return SERDES_TURN_DEG_SUCCESS;
+}
+
+
+size_t deserialize_turns_from_deg(const char *const serialized_degs, const size_t len, const char separator, unsigned int bit_width, unsigned int *const turns, const size_t max_num, const char **const endptrs, const char **const next)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    return conv_deg_strings_to_turns(serialized_degs, serialized_degs + len, separator, bit_width, turns, max_num, endptrs, next);
+}
+
+
+void init_turns_from_deg_parser(struct serdes_turn_deg_parser *const parser, const char separator, unsigned int bit_width, const serdes_turn_deg_parser_callback callback, void *const context)
+{
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    parser->bit_width = bit_width;
+    parser->separator = separator;
+    parser->callback = callback;
+    parser->context = context;
+    reset_parser_field(parser);
+}
+
+
+size_t deserialize_turns_from_deg_chunk(struct serdes_turn_deg_parser *const parser, const char *const chunk, const size_t len)
+{
+    const char *const end = chunk + len;
+    const char *ptr = chunk;
+    size_t num = 0;
+
+    while (ptr != end) {
+        const char *const field_end = find_char(ptr, end, parser->separator);
+        if (parser->state == PARSER_STATE_SPACE && parser->length == 0 && field_end != end) {
+            /* The whole field is in the chunk. */
+            unsigned long deg;
+            unsigned int decimals;
+            const char *const endptr = parse_deg(ptr, field_end, MAX_DECIMALS(parser->bit_width), &deg, &decimals);
+            int result = check_parsed_deg(ptr, endptr, field_end);
+            if (result == SERDES_TURN_DEG_SUCCESS && endptr != field_end) {
+                result = SERDES_TURN_DEG_ERR_INVALID_CHAR;
+            }
+            parser->callback(parser->context, conv_scaled_deg_to_turn(deg, decimals, parser->bit_width), result);
+        } else {
+            /* The field begins in a previous chunk, or continues to a next chunk. */
+            for (; ptr != field_end && parser->state != PARSER_STATE_TAIL; ptr++) {
+                parse_deg_char(parser, *ptr);
+            }
+            if (field_end == end) {
+                break;
+            }
+            finish_parser_field(parser);
+        }
+        num++;
+        /* skip the separator */
+        ptr = field_end + 1;
+    }
+    return num;
+}
+
+
+size_t finish_turns_from_deg_parser(struct serdes_turn_deg_parser *const parser)
+{
+    if (parser->state == PARSER_STATE_SPACE && parser->length == 0) {
+        return 0;
+    }
+    finish_parser_field(parser);
+    return 1;
+}
+
+
+size_t deserialize_turns_from_deg_parallel(const char *const serialized_degs, const size_t len, const char separator, unsigned int bit_width, unsigned int *const turns, const size_t max_num, const char **const endptrs, const char **const next, size_t num_of_tasks, const serdes_turn_deg_executor executor, void *const context)
+{
+    const char *const end = serialized_degs + len;
+    struct ParallelDeserialization work;
+    size_t i;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+    PARAM_CHECK(num_of_tasks, 1, SERDES_TURN_DEG_MAX_TASKS);
+    num_of_tasks = limit_num_of_tasks(num_of_tasks, len, PARALLEL_MIN_CHARS_PER_TASK);
+    if (num_of_tasks == 1) {
+        return conv_deg_strings_to_turns(serialized_degs, end, separator, bit_width, turns, max_num, endptrs, next);
+    }
+
+    /* Split the text after the separators near the even bounds. */
+    work.bounds[0] = serialized_degs;
+    for (i = 1; i < num_of_tasks; i++) {
+        const char *ptr = serialized_degs + task_begin(len, num_of_tasks, i);
+        if (ptr < work.bounds[i - 1]) {
+            ptr = work.bounds[i - 1];
+        }
+        ptr = find_char(ptr, end, separator);
+        work.bounds[i] = ptr != end ? ptr + 1 : end;
+    }
+    work.bounds[num_of_tasks] = end;
+    work.separator = separator;
+    work.bit_width = bit_width;
+    work.turns = turns;
+    work.endptrs = endptrs;
+    work.num_of_tasks = num_of_tasks;
+
+    /* The first pass counts the fields, and the prefix sum of them is the offset of each task in turns. */
+    run_tasks(num_of_tasks, count_fields_task, &work, executor, context);
+    work.offsets[0] = 0;
+    for (i = 0; i < num_of_tasks; i++) {
+        const size_t rest = max_num - work.offsets[i];
+        if (work.nums[i] > rest) {
+            work.nums[i] = rest;
+        }
+        work.offsets[i + 1] = work.offsets[i] + work.nums[i];
+    }
+
+    /* The second pass deserializes the fields. */
+    run_tasks(num_of_tasks, deserialize_task, &work, executor, context);
+    if (next != NULL) {
+        /* The first task that stops before its end has the next field, or all fields are deserialized. */
+        *next = end;
+        for (i = 0; i < num_of_tasks; i++) {
+            if (work.nexts[i] != work.bounds[i + 1]) {
+                *next = work.nexts[i];
+                break;
+            }
+        }
+    }
+    return work.offsets[num_of_tasks];
+}
+
+
+unsigned int conv_deg_to_turn(double deg, unsigned int bit_width)
+{
+    unsigned long turn;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+    deg = fmod(deg, 360.0);
+    if (deg < 0.0) {
+        /* deg is in range [0, 360] for any sign and any bit-width. 360 is rounded from a tiny negative degree. */
+        deg += 360.0;
+    }
+    deg = ldexp(deg, bit_width);
+    /* deg is less than 2**(bit_width + 9), so it fits in unsigned long. */
+    turn = (unsigned long)deg / 180;
+    if (turn & 1) {
+        turn = (turn / 2) + 1;
     } else {
         turn = turn / 2;
     }
-    return turn;
+    return (unsigned int)turn & TURN_MASK(bit_width);
+}
+
+
+/** The absolute value of a degree under it is converted by SIMD, so that trunc(deg / 360) * 360 is exact. */
+#define SERDES_TURN_DEG_SIMD_MAX_DEG 4503599627370496.0 /* 2**52 */
+/** Adding it to an integer in double makes the lower bits of the mantissa the integer in two's complement. */
+#define SERDES_TURN_DEG_SIMD_INT_MAGIC 6755399441055744.0 /* 2**52 + 2**51 */
+
+#ifdef SERDES_TURN_DEG_USE_AVX512
+/** Convert degrees to angles @ turn by AVX-512, 8 degrees at once.
+    \return The number of the converted degrees, which is a multiple of 8.
+*/
+static size_t conv_degs_to_turns_avx512(const double *const degs, const size_t num, const unsigned int bit_width, unsigned int *const turns)
+{
+    const __m512d c360 = _mm512_set1_pd(360.0);
+    const __m512d c180 = _mm512_set1_pd(180.0);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d max_deg = _mm512_set1_pd(SERDES_TURN_DEG_SIMD_MAX_DEG);
+    const __m512d magic = _mm512_set1_pd(SERDES_TURN_DEG_SIMD_INT_MAGIC);
+    const __m512d scale = _mm512_set1_pd(ldexp(1.0, (int)bit_width));
+    const __m512i mask = _mm512_set1_epi64((long)TURN_MASK(bit_width));
+    const __m512i one = _mm512_set1_epi64(1);
+    size_t i;
+    size_t j;
+
+    for (i = 0; i + 8 <= num; i += 8) {
+        const __m512d x = _mm512_loadu_pd(degs + i);
+        __m512d q;
+        __m512d r;
+        __m512i bits;
+        if (_mm512_cmp_pd_mask(_mm512_abs_pd(x), max_deg, _CMP_LT_OQ) != 0xFF) {
+            /* Too large, infinity, or NaN */
+            for (j = i; j < i + 8; j++) {
+                turns[j] = conv_deg_to_turn(degs[j], bit_width);
+            }
+            continue;
+        }
+        /* r = fmod(x, 360.0), exactly */
+        q = _mm512_roundscale_pd(_mm512_div_pd(x, c360), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        r = _mm512_sub_pd(x, _mm512_mul_pd(q, c360));
+        /* x / 360 may be rounded up to the next integer, which makes the sign of r opposite. */
+        r = _mm512_mask_add_pd(r, _mm512_cmp_pd_mask(r, zero, _CMP_LT_OQ) & _mm512_cmp_pd_mask(x, zero, _CMP_GT_OQ), r, c360);
+        r = _mm512_mask_sub_pd(r, _mm512_cmp_pd_mask(r, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(x, zero, _CMP_LT_OQ), r, c360);
+        /* r += 360 if r < 0, as same as conv_deg_to_turn() */
+        r = _mm512_mask_add_pd(r, _mm512_cmp_pd_mask(r, zero, _CMP_LT_OQ), r, c360);
+        /* (unsigned long)ldexp(r, bit_width) / 180 */
+        q = _mm512_roundscale_pd(_mm512_mul_pd(r, scale), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        q = _mm512_roundscale_pd(_mm512_div_pd(q, c180), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        /* turn = q / 2 + (q & 1). q is in the lower bits of the mantissa, and the exponent is masked out at last. */
+        bits = _mm512_castpd_si512(_mm512_add_pd(q, magic));
+        bits = _mm512_and_si512(_mm512_add_epi64(_mm512_srli_epi64(bits, 1), _mm512_and_si512(bits, one)), mask);
+        _mm256_storeu_si256((__m256i *)(turns + i), _mm512_cvtepi64_epi32(bits));
+    }
+    return i;
+}
+#elif defined(SERDES_TURN_DEG_USE_AVX2)
+/** Convert degrees to angles @ turn by AVX2, 4 degrees at once.
+    \return The number of the converted degrees, which is a multiple of 4.
+*/
+static size_t conv_degs_to_turns_avx2(const double *const degs, const size_t num, const unsigned int bit_width, unsigned int *const turns)
+{
+    const __m256d c360 = _mm256_set1_pd(360.0);
+    const __m256d c180 = _mm256_set1_pd(180.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d max_deg = _mm256_set1_pd(SERDES_TURN_DEG_SIMD_MAX_DEG);
+    const __m256d magic = _mm256_set1_pd(SERDES_TURN_DEG_SIMD_INT_MAGIC);
+    const __m256d scale = _mm256_set1_pd(ldexp(1.0, (int)bit_width));
+    const __m256i mask = _mm256_set1_epi64x((long)TURN_MASK(bit_width));
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i even_lanes = _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0);
+    size_t i;
+    size_t j;
+
+    for (i = 0; i + 4 <= num; i += 4) {
+        const __m256d x = _mm256_loadu_pd(degs + i);
+        __m256d q;
+        __m256d r;
+        __m256i bits;
+        if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, x), max_deg, _CMP_LT_OQ)) != 0xF) {
+            /* Too large, infinity, or NaN */
+            for (j = i; j < i + 4; j++) {
+                turns[j] = conv_deg_to_turn(degs[j], bit_width);
+            }
+            continue;
+        }
+        /* r = fmod(x, 360.0), exactly */
+        q = _mm256_round_pd(_mm256_div_pd(x, c360), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        r = _mm256_sub_pd(x, _mm256_mul_pd(q, c360));
+        /* x / 360 may be rounded up to the next integer, which makes the sign of r opposite. */
+        r = _mm256_add_pd(r, _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(r, zero, _CMP_LT_OQ), _mm256_cmp_pd(x, zero, _CMP_GT_OQ)), c360));
+        r = _mm256_sub_pd(r, _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(r, zero, _CMP_GT_OQ), _mm256_cmp_pd(x, zero, _CMP_LT_OQ)), c360));
+        /* r += 360 if r < 0, as same as conv_deg_to_turn() */
+        r = _mm256_add_pd(r, _mm256_and_pd(_mm256_cmp_pd(r, zero, _CMP_LT_OQ), c360));
+        /* (unsigned long)ldexp(r, bit_width) / 180 */
+        q = _mm256_round_pd(_mm256_mul_pd(r, scale), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        q = _mm256_round_pd(_mm256_div_pd(q, c180), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        /* turn = q / 2 + (q & 1). q is in the lower bits of the mantissa, and the exponent is masked out at last. */
+        bits = _mm256_castpd_si256(_mm256_add_pd(q, magic));
+        bits = _mm256_and_si256(_mm256_add_epi64(_mm256_srli_epi64(bits, 1), _mm256_and_si256(bits, one)), mask);
+        _mm_storeu_si128((__m128i *)(turns + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(bits, even_lanes)));
+    }
+    return i;
+}
+#endif
+
+
+void conv_degs_to_turns(const double *const degs, const size_t num, unsigned int bit_width, unsigned int *const turns)
+{
+    size_t i = 0;
+
+    PARAM_CHECK(bit_width, SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_BUILD_MAX_BIT_WIDTH);
+
+#if defined(SERDES_TURN_DEG_USE_AVX512)
+    i = conv_degs_to_turns_avx512(degs, num, bit_width, turns);
+#elif defined(SERDES_TURN_DEG_USE_AVX2)
+    i = conv_degs_to_turns_avx2(degs, num, bit_width, turns);
+#endif
+    for (; i < num; i++) {
+        turns[i] = conv_deg_to_turn(degs[i], bit_width);
+    }
+}
+
+
+int serdes_turn_deg_get_stats(struct serdes_turn_deg_stats *const stats)
+{
+    assert(stats != NULL);
+#ifdef SERDES_TURN_DEG_STATS
+    *stats = thread_stats;
+    return 1;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return 0;
+#endif
+}
+
+
+void serdes_turn_deg_reset_stats(void)
+{
+#ifdef SERDES_TURN_DEG_STATS
+    memset(&thread_stats, 0, sizeof(thread_stats));
+#endif
 }
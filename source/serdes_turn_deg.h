@@ -21,19 +21,69 @@
 #ifndef SERDES_TURN_DEG_H_
 #define SERDES_TURN_DEG_H_
 
+#include <limits.h>
+#include <stddef.h>
+
 /** The required buffer length. */
 #define SERDES_TURN_DEG_BUF_SIZE 10
 
 /** The maximum precision. */
 #define SERDES_TURN_DEG_MAX_PRECISION 5
-/** The minimum precision. */
-#define SERDES_TURN_DEG_MIN_PRECISION (-2)
 
 /** The maximum bit-width of the turn. */
 #define SERDES_TURN_DEG_MAX_BIT_WIDTH 22
+
+/** The required buffer length to serialize num angles at once.
+    \param [in] num The number of the angles.
+*/
+#define SERDES_TURN_DEG_BATCH_BUF_SIZE(num) ((num) * SERDES_TURN_DEG_BUF_SIZE + 1)
+
+#if !defined(SERDES_TURN_DEG_DEBUG_FORCE_32BIT) && (ULONG_MAX >> 31 >> 31) >= 3
+/** Defined if unsigned long has 64 bits at least. Then the functions also accept the bit-width up to SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH and the precision up to SERDES_TURN_DEG_WIDE_MAX_PRECISION, where the range in their documents says SERDES_TURN_DEG_MAX_BIT_WIDTH and SERDES_TURN_DEG_MAX_PRECISION. */
+#define SERDES_TURN_DEG_WIDE
+#endif
+
+/** The required buffer length if the bit-width is more than SERDES_TURN_DEG_MAX_BIT_WIDTH or the precision is more than SERDES_TURN_DEG_MAX_PRECISION. */
+#define SERDES_TURN_DEG_WIDE_BUF_SIZE 13
+
+/** The maximum precision if SERDES_TURN_DEG_WIDE is defined. */
+#define SERDES_TURN_DEG_WIDE_MAX_PRECISION 8
+
+/** The maximum bit-width of the turn if SERDES_TURN_DEG_WIDE is defined. */
+#define SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH 32
+
+/** The required buffer length to serialize num angles at once with SERDES_TURN_DEG_WIDE_BUF_SIZE.
+    \param [in] num The number of the angles.
+*/
+#define SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num) ((num) * SERDES_TURN_DEG_WIDE_BUF_SIZE + 1)
+
+/** The minimum precision. */
+#define SERDES_TURN_DEG_MIN_PRECISION (-2)
+
 /** The minimum bit-width of the turn. */
 #define SERDES_TURN_DEG_MIN_BIT_WIDTH 1
 
+/** The number of the bins of the histogram of the parsed lengths in struct serdes_turn_deg_stats. The last bin counts the longer texts. */
+#define SERDES_TURN_DEG_STATS_NUM_OF_LEN_BINS 24
+
+/** The statistics of the calls in a thread, which the library collects only if it is built with SERDES_TURN_DEG_STATS. The layout doesn't depend on SERDES_TURN_DEG_WIDE. */
+struct serdes_turn_deg_stats {
+    unsigned long serialized_by_bit_width[SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH + 1]; /**< The number of the serialized angles for each bit-width. */
+    unsigned long serialized_shortest; /**< The number of the angles serialized by serialize_turn_to_deg() and serialize_turns_to_deg(). */
+    unsigned long serialized_by_precision[SERDES_TURN_DEG_WIDE_MAX_PRECISION - SERDES_TURN_DEG_MIN_PRECISION + 1]; /**< The number of the angles serialized with a precision, for each precision - SERDES_TURN_DEG_MIN_PRECISION. */
+    unsigned long serialized_length[SERDES_TURN_DEG_WIDE_BUF_SIZE]; /**< The histogram of the lengths of the serialized strings. */
+    unsigned long carries; /**< The number of the strings whose lowest digit overflowed and was carried up. */
+    unsigned long suppressions; /**< The number of the strings whose lower zeros were suppressed by the *_ps() functions. */
+    unsigned long deserialized_by_bit_width[SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH + 1]; /**< The number of the deserialized angles for each bit-width. */
+    unsigned long parsed_length[SERDES_TURN_DEG_STATS_NUM_OF_LEN_BINS]; /**< The histogram of the lengths of the parsed texts including the leading white spaces. */
+    unsigned long truncated_digits; /**< The number of the digits ignored after the maximum precision. */
+    unsigned long no_digits; /**< The number of the texts without digits, that is the deserialization fails. */
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Serialize an angle @ turn expressed by a fixed point number to @ degree.
     \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
     \param [in] turn The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place. It means the angle as an integer is in range [0, 2**bit_width - 1], that is [0, 1) turn = [0, 360) degree.
@@ -77,20 +127,383 @@ extern char *serialize_turn_to_deg_p(char *buf, unsigned int turn, unsigned int
 */
 extern char *serialize_turn_to_deg_ps(char *buf, unsigned int turn, unsigned int bit_width, int precision);
 
+/** Serialize some angles @ turn expressed by fixed point numbers to @ degree at once.
+    \param [inout] buf A buffer to write the serialized strings. The length must be at least SERDES_TURN_DEG_BATCH_BUF_SIZE(num), or the return value of serialize_turns_to_deg_length() + 1.
+    \param [in] turns The angles @ turn. Each angle is the same as turn in serialize_turn_to_deg().
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] separator The character to put between the serialized strings.
+    \return The point to NUL character in buf.
+
+    This function writes the same strings as serialize_turn_to_deg() one after another into buf, and puts separator between them. No separator is put after the last string. buf is an empty string if num is 0.
+*/
+extern char *serialize_turns_to_deg(char *buf, const unsigned int *turns, size_t num, unsigned int bit_width, char separator);
+
+/** The variation of serialize_turns_to_deg(), which you can specify a minimum digit number.
+    \param [inout] buf A buffer to write the serialized strings. The length must be at least SERDES_TURN_DEG_BATCH_BUF_SIZE(num), or the return value of serialize_turns_to_deg_length() + 1.
+    \param [in] turns The angles @ turn. Each angle is the same as turn in serialize_turn_to_deg_p().
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] precision The minimum digit number after the decimal point. It must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION].
+    \param [in] separator The character to put between the serialized strings.
+    \return The point to NUL character in buf.
+
+    Each string is the same as serialize_turn_to_deg_p() writes.
+*/
+extern char *serialize_turns_to_deg_p(char *buf, const unsigned int *turns, size_t num, unsigned int bit_width, int precision, char separator);
+
+/** The variation of serialize_turns_to_deg_p(), which suppresses a series of the lowest side 0 after the decimal point.
+    \param [inout] buf A buffer to write the serialized strings. The length must be at least SERDES_TURN_DEG_BATCH_BUF_SIZE(num), or the return value of serialize_turns_to_deg_length() + 1.
+    \param [in] turns The angles @ turn. Each angle is the same as turn in serialize_turn_to_deg_ps().
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] precision The minimum digit number after the decimal point. It must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION].
+    \param [in] separator The character to put between the serialized strings.
+    \return The point to NUL character in buf.
+
+    Each string is the same as serialize_turn_to_deg_ps() writes.
+*/
+extern char *serialize_turns_to_deg_ps(char *buf, const unsigned int *turns, size_t num, unsigned int bit_width, int precision, char separator);
+
+/** The length of a fixed-width string without NUL.
+    \param [in] precision The precision of the string.
+*/
+#define SERDES_TURN_DEG_FIXED_WIDTH(precision) (3 + ((precision) > 0 ? (precision) + 1 : 0))
+
+/** The minimum precision of serialize_turn_to_deg_fixed() for a bit-width.
+    \param [in] bit_width The bit-width of the angles. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \return The minimum precision that can recover all angles of bit_width.
+
+    It's the smallest precision P that 360 * 10**(2 + P) > 100 * 2**bit_width, that is, the digit at the lowest place is always enough to recover the angle.
+*/
+extern int deg_fixed_min_precision(unsigned int bit_width);
+
+/** Serialize an angle @ turn to a fixed-width string @ degree.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_FIXED_WIDTH(precision) + 1.
+    \param [in] turn The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] precision The digit number after the decimal point. It must be in range [deg_fixed_min_precision(bit_width), SERDES_TURN_DEG_MAX_PRECISION].
+    \param [in] pad The character to fill the upper places of the integer part, such as ' ' and '0'.
+    \return The point to NUL character in buf, that is buf + SERDES_TURN_DEG_FIXED_WIDTH(precision). NULL if precision is out of range, and then nothing is written to buf.
+    \invariant turn == deserialize_turn_from_deg_fixed(buf, bit_width, precision)
+
+    The string is the same as serialize_turn_to_deg_p() writes, but the integer part is always 3 characters filled with pad. So every string has the same width and the decimal point at the same position, e.g. "  0.50" and "359.12" if precision is 2 and pad is ' '.
+*/
+extern char *serialize_turn_to_deg_fixed(char *buf, unsigned int turn, unsigned int bit_width, int precision, char pad);
+
+/** The lowest place of the digits plus this value is in the upper 4 bits of the header of the packed BCD. It doesn't depend on the build, so the packed BCD is the same in any build. */
+#define SERDES_TURN_DEG_BCD_PLACE_BIAS 8
+
+/** The maximum length of the packed BCD: the header and the digits of 2 places in a byte. */
+#define SERDES_TURN_DEG_BCD_BUF_SIZE (1 + (SERDES_TURN_DEG_WIDE_MAX_PRECISION - SERDES_TURN_DEG_MIN_PRECISION + 2) / 2)
+
+/** Serialize an angle @ turn to the shortest degree in a packed BCD (binary-coded decimal).
+    \param [out] buf A buffer to write the packed BCD. The length must be at least SERDES_TURN_DEG_BCD_BUF_SIZE.
+    \param [in] turn The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \return The length of the packed BCD in bytes.
+    \invariant turn == deserialize_turn_from_deg_bcd() of the packed BCD
+
+    The digits are the same as serialize_turn_to_deg() writes without the leading zeros. The first byte is the header: the upper 4 bits are the place of the lowest digit plus SERDES_TURN_DEG_BCD_PLACE_BIAS, and the lower 4 bits are the number of the digits. The digits follow from the highest place, 2 digits in a byte and the higher one in the upper 4 bits. The lower 4 bits of the last byte are 0 if the number of the digits is odd. For example, "123.45" is 0x65 0x12 0x34 0x50, "0.09" is 0x61 0x90, and "0" is 0xA1 0x00.
+*/
+extern size_t serialize_turn_to_deg_bcd(unsigned char *buf, unsigned int turn, unsigned int bit_width);
+
+/** The serialize function that an incremental serializer is equivalent to. */
+enum serdes_turn_deg_mode {
+    SERDES_TURN_DEG_MODE_SHORTEST, /**< serialize_turn_to_deg() */
+    SERDES_TURN_DEG_MODE_P, /**< serialize_turn_to_deg_p() */
+    SERDES_TURN_DEG_MODE_PS /**< serialize_turn_to_deg_ps() */
+};
+
+/** Calculate the length of the serialized string without serializing it.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] mode The serialize function to calculate the length of.
+    \param [in] precision The minimum digit number after the decimal point for SERDES_TURN_DEG_MODE_P and SERDES_TURN_DEG_MODE_PS. It must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION]. It is ignored for SERDES_TURN_DEG_MODE_SHORTEST.
+    \return The length of the string without NUL, which is the same as the return value of serialize_turn_to_deg(), serialize_turn_to_deg_p(), or serialize_turn_to_deg_ps() minus buf.
+
+    This function generates the digits, but doesn't convert them to the string.
+*/
+extern size_t serialize_turn_to_deg_length(unsigned int turn, unsigned int bit_width, enum serdes_turn_deg_mode mode, int precision);
+
+/** Calculate the length of the serialized strings separated by a character without serializing them.
+    \param [in] turns The angles @ turn.
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] mode The serialize function to calculate the length of.
+    \param [in] precision The same as serialize_turn_to_deg_length().
+    \return The length of the strings and the separators without NUL, which is the same as the return value of serialize_turns_to_deg(), serialize_turns_to_deg_p(), or serialize_turns_to_deg_ps() minus buf.
+
+    The batch serialize functions write nothing after NUL, so the return value + 1 bytes are enough for their buf instead of SERDES_TURN_DEG_BATCH_BUF_SIZE(num). This function uses the tables of the serialized strings if they're generated at build time.
+*/
+extern size_t serialize_turns_to_deg_length(const unsigned int *turns, size_t num, unsigned int bit_width, enum serdes_turn_deg_mode mode, int precision);
+
+/** Convert an angle @ turn to the decimal degree as an integer mantissa and a decimal exponent without the string.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] mode The serialize function that selects the digits.
+    \param [in] precision The same as serialize_turn_to_deg_length().
+    \param [out] exponent The decimal exponent, which is in range [-SERDES_TURN_DEG_MAX_PRECISION, 0] if bit_width and precision are up to SERDES_TURN_DEG_MAX_BIT_WIDTH and SERDES_TURN_DEG_MAX_PRECISION, and in range [-SERDES_TURN_DEG_WIDE_MAX_PRECISION, 0] otherwise if SERDES_TURN_DEG_WIDE is defined.
+    \return The mantissa, which is less than 360 * 10**-*exponent, that is less than 360 * 10**SERDES_TURN_DEG_MAX_PRECISION, or 360 * 10**SERDES_TURN_DEG_WIDE_MAX_PRECISION for the wide bit-width or precision.
+
+    The degree is the mantissa * 10***exponent, and it has the same digits as the string that serialize_turn_to_deg(), serialize_turn_to_deg_p(), or serialize_turn_to_deg_ps() writes for the mode: *exponent is minus the number of the digits after the decimal point. For example, "12.345" is 12345 and -3, "90" is 90 and 0, and "90.000" is 90000 and -3.
+*/
+extern unsigned long conv_turn_to_deg_decimal(unsigned int turn, unsigned int bit_width, enum serdes_turn_deg_mode mode, int precision, int *exponent);
+
+/** The state of an incremental serializer, which keeps the digits of the previous angle. Initialize it by init_turn_to_deg_serializer(). The members are private. */
+struct serdes_turn_deg_serializer {
+    unsigned int bit_width; /**< The bit-width of the angles. */
+    int mode; /**< enum serdes_turn_deg_mode */
+    int place; /**< The maximum place of digit to output. */
+    unsigned int turn; /**< The previous angle. */
+    int lowest_place; /**< The lowest place of digits and remainders, or more than the highest place if there is no previous angle. */
+    char digits[SERDES_TURN_DEG_WIDE_BUF_SIZE]; /**< The digits of the previous angle before the rounding. */
+    unsigned int remainders[SERDES_TURN_DEG_WIDE_BUF_SIZE]; /**< The remainders after each digit of the previous angle. */
+};
+
+/** Initialize an incremental serializer.
+    \param [out] serializer The state of the serializer.
+    \param [in] bit_width The bit-width of the angles. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] mode The serialize function that serialize_turn_to_deg_incremental() is equivalent to.
+    \param [in] precision The minimum digit number after the decimal point for SERDES_TURN_DEG_MODE_P and SERDES_TURN_DEG_MODE_PS. It must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION]. It is ignored for SERDES_TURN_DEG_MODE_SHORTEST.
+*/
+extern void init_turn_to_deg_serializer(struct serdes_turn_deg_serializer *serializer, unsigned int bit_width, enum serdes_turn_deg_mode mode, int precision);
+
+/** Serialize an angle @ turn to @ degree, reusing the digits of the previous angle.
+    \param [inout] serializer The state of the serializer, which is updated for the next angle.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \return The point to NUL character in buf.
+
+    The serialized string is the same as serialize_turn_to_deg(), serialize_turn_to_deg_p(), or serialize_turn_to_deg_ps() writes. If turn differs from the previous angle by a few LSBs, such as a sweep or a scan, the upper digits don't change, and this function updates their remainders by an addition instead of a division. It's effective for the bit-width up to 22; the larger bit-widths are serialized from scratch.
+*/
+extern char *serialize_turn_to_deg_incremental(struct serdes_turn_deg_serializer *serializer, char *buf, unsigned int turn);
+
+/** An output of serialize_turn_to_deg_multi(). */
+struct serdes_turn_deg_output {
+    char *buf; /**< A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE. */
+    enum serdes_turn_deg_mode mode; /**< The serialize function that the output is equivalent to. */
+    int precision; /**< The same as serialize_turn_to_deg_length(). */
+    char *end; /**< The point to NUL character in buf, which serialize_turn_to_deg_multi() sets. */
+};
+
+/** Serialize an angle @ turn to the strings of some modes and precisions at once.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [inout] outputs The buffers, the modes, and the precisions of the strings. This function sets the end of each output.
+    \param [in] num The number of the outputs.
+
+    Each string is the same as serialize_turn_to_deg(), serialize_turn_to_deg_p(), or serialize_turn_to_deg_ps() writes for the mode and the precision of the output. The outputs differ only in the place where the generation of the digits stops and rounds, so this function generates the digits once down to the lowest place of them. The bit-width more than 22 is serialized for each output.
+*/
+extern void serialize_turn_to_deg_multi(unsigned int turn, unsigned int bit_width, struct serdes_turn_deg_output *outputs, size_t num);
+
 /** Deserialize from degree to an angle @ turn expressed by a fixed point number.
     \param [in] serialized_deg A real number of a degree.
     \param [in] bit_width The bit-width of the return value. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
     \param [out] endptr The pointer to set the next character of the last one that used the conversion if endptr is not NULL.
     \return The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place. It means the angle as an integer is in range [0, 2**bit_width - 1], that is [0, 1) turn = [0, 360) degree.
-    \note This function accepts a text matched at the regexp "\s*[0-9]{0,2}(\.[0-9]*)?" as serialized_deg. If *endptr points to a digit, it means the integer part is too long.
+    \note This function accepts a text matched at the regexp "\s*[0-9]{0,2}(\.[0-9]*)?" as serialized_deg. If *endptr points to a digit, it means the integer part is too long. The digits after SERDES_TURN_DEG_MAX_PRECISION places are ignored if bit_width is up to SERDES_TURN_DEG_MAX_BIT_WIDTH, and the digits after SERDES_TURN_DEG_WIDE_MAX_PRECISION places otherwise.
 */
 extern unsigned int deserialize_turn_from_deg(const char *serialized_deg, unsigned int bit_width, const char **endptr);
 
+/** The result of deserialize_turn_from_deg_n(): Success. */
+#define SERDES_TURN_DEG_SUCCESS 0
+/** The result of deserialize_turn_from_deg_n(): The text has no digits. */
+#define SERDES_TURN_DEG_ERR_NO_DIGITS (-1)
+/** The result of deserialize_turn_from_deg_n(): The integer part of the text is too long. */
+#define SERDES_TURN_DEG_ERR_OUT_OF_RANGE (-2)
+
+/** The result of a field of deserialize_turns_from_deg_chunk(): The field has the characters after the degree. */
+#define SERDES_TURN_DEG_ERR_INVALID_CHAR (-3)
+
+/** The variation of deserialize_turn_from_deg(), which deserializes a text that isn't terminated by NUL.
+    \param [in] serialized_deg A real number of a degree. It need not be terminated by NUL.
+    \param [in] len The length of serialized_deg. This function never reads serialized_deg[len] and after.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [out] turn The angle @ turn if the result is SERDES_TURN_DEG_SUCCESS. It's unchanged if the result is an error.
+    \param [out] consumed The length of the text that used the conversion if consumed is not NULL.
+    \return SERDES_TURN_DEG_SUCCESS, SERDES_TURN_DEG_ERR_NO_DIGITS if the text has no digits, or SERDES_TURN_DEG_ERR_OUT_OF_RANGE if the integer part is too long.
+
+    The text is deserialized as same as deserialize_turn_from_deg() deserializes it terminated by NUL at len, and *consumed is the same as *endptr - serialized_deg. A NUL character in the text also ends the conversion.
+*/
+extern int deserialize_turn_from_deg_n(const char *serialized_deg, size_t len, unsigned int bit_width, unsigned int *turn, size_t *consumed);
+
+/** Deserialize a fixed-width string that serialize_turn_to_deg_fixed() writes.
+    \param [in] serialized_deg A fixed-width string. It need not be terminated by NUL, and this function reads just SERDES_TURN_DEG_FIXED_WIDTH(precision) characters.
+    \param [in] bit_width The bit-width of the return value. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] precision The precision of the string. It must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION].
+    \return The angle @ turn.
+    \warning This function doesn't validate the string. It takes each digit at the fixed position as (c & 0x0F), so both ' ' and '0' as the padding are 0.
+
+    Since the string has no variable part, this function takes the digits without scanning and branches. A record of fixed-width strings can be deserialized at any offset.
+*/
+extern unsigned int deserialize_turn_from_deg_fixed(const char *serialized_deg, unsigned int bit_width, int precision);
+
+/** Deserialize a packed BCD that serialize_turn_to_deg_bcd() writes.
+    \param [in] bcd A packed BCD.
+    \param [in] len The length of bcd. This function never reads bcd[len] and after.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [out] turn The angle @ turn if the result is SERDES_TURN_DEG_SUCCESS. It's unchanged if the result is an error.
+    \param [out] consumed The length of the packed BCD if consumed is not NULL and the result is SERDES_TURN_DEG_SUCCESS.
+    \return SERDES_TURN_DEG_SUCCESS, SERDES_TURN_DEG_ERR_NO_DIGITS if len is too short for the header or the digits or the header has no digits, or SERDES_TURN_DEG_ERR_OUT_OF_RANGE if a digit is more than 9 or the highest place is more than 2.
+
+    The degree is converted to the turn directly without the text. It's rounded in the same way as deserialize_turn_from_deg(), so the integer part is taken modulo 360 and the digits lower than the lowest place for bit_width are truncated.
+*/
+extern int deserialize_turn_from_deg_bcd(const unsigned char *bcd, size_t len, unsigned int bit_width, unsigned int *turn, size_t *consumed);
+
+/** Deserialize some degrees separated by a character to angles @ turn at once.
+    \param [in] serialized_degs Real numbers of degrees separated by separator. It need not be terminated by NUL.
+    \param [in] len The length of serialized_degs.
+    \param [in] separator The character between the real numbers, such as ',' and '\n'.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [out] turns The angles @ turn. The length must be at least max_num.
+    \param [in] max_num The maximum number of the real numbers to deserialize.
+    \param [out] endptrs The pointers to the next character of the last one that used the conversion of each real number, if endptrs is not NULL. The length must be at least max_num.
+    \param [out] next The pointer to the first real number that isn't deserialized, or serialized_degs + len if all real numbers are deserialized, if next is not NULL.
+    \return The number of the deserialized real numbers.
+
+    Each real number (field) between the separators is deserialized as same as deserialize_turn_from_deg() deserializes the field terminated by NUL; turns[i] and endptrs[i] are the same result, so endptrs[i] points to the separator or serialized_degs + len if the whole field is converted. A separator at the end of serialized_degs doesn't make an empty field.
+
+    This function uses SSE2/AVX2 to find the separators and the digits if the compiler supports them.
+*/
+extern size_t deserialize_turns_from_deg(const char *serialized_degs, size_t len, char separator, unsigned int bit_width, unsigned int *turns, size_t max_num, const char **endptrs, const char **next);
+
+/** A callback of a streaming parser, which receives each deserialized field.
+    \param [inout] context The context that the caller gives to init_turns_from_deg_parser().
+    \param [in] turn The angle @ turn, which is the same as deserialize_turns_from_deg() deserializes from the field.
+    \param [in] result SERDES_TURN_DEG_SUCCESS, SERDES_TURN_DEG_ERR_NO_DIGITS if the field has no digits, SERDES_TURN_DEG_ERR_OUT_OF_RANGE if the integer part is too long, or SERDES_TURN_DEG_ERR_INVALID_CHAR if the field has the characters after the degree.
+*/
+typedef void (*serdes_turn_deg_parser_callback)(void *context, unsigned int turn, int result);
+
+/** The state of a streaming parser, which keeps the partial field between the chunks. Initialize it by init_turns_from_deg_parser(). The members are private. */
+struct serdes_turn_deg_parser {
+    unsigned int bit_width; /**< The bit-width of the angles. */
+    char separator; /**< The character between the fields. */
+    int state; /**< The part of the field that the next character belongs to. */
+    int result; /**< The result of the field if the rest is ignored. */
+    unsigned long deg; /**< The parsed degree multiplied by 10**decimals. */
+    unsigned int count; /**< The number of the parsed digits. */
+    unsigned int decimals; /**< The number of the converted digits after the decimal point. */
+    size_t length; /**< The number of the parsed characters. */
+    serdes_turn_deg_parser_callback callback; /**< The callback to receive the fields. */
+    void *context; /**< The context of callback. */
+};
+
+/** Initialize a streaming parser.
+    \param [out] parser The state of the parser.
+    \param [in] separator The character between the real numbers, such as ',' and '\n'.
+    \param [in] bit_width The bit-width of the angles. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] callback The function to call for each field.
+    \param [in] context The context of callback.
+*/
+extern void init_turns_from_deg_parser(struct serdes_turn_deg_parser *parser, char separator, unsigned int bit_width, serdes_turn_deg_parser_callback callback, void *context);
+
+/** Deserialize a chunk of the degrees separated by a character, which may split a field at any position.
+    \param [inout] parser The state of the parser, which keeps the last field if it doesn't end in the chunk.
+    \param [in] chunk The next characters of the stream. It need not be terminated by NUL.
+    \param [in] len The length of chunk.
+    \return The number of the fields that end in the chunk.
+
+    The callback is called for each field that ends by a separator in the chunk. The fields are the same as deserialize_turns_from_deg() deserializes from the whole stream at once, without copying the partial field to a buffer. A field in a chunk is deserialized by the same code as deserialize_turns_from_deg(), and only the field across the chunks is parsed character by character.
+*/
+extern size_t deserialize_turns_from_deg_chunk(struct serdes_turn_deg_parser *parser, const char *chunk, size_t len);
+
+/** Finish the stream of a streaming parser.
+    \param [inout] parser The state of the parser, which is reset for the next stream.
+    \return The number of the fields, that is 1 if the last field doesn't end by a separator, or 0.
+
+    The callback is called for the last field if the stream doesn't end by a separator, as same as deserialize_turns_from_deg() doesn't make an empty field after the separator at the end.
+*/
+extern size_t finish_turns_from_deg_parser(struct serdes_turn_deg_parser *parser);
+
 /** Convert degree to an angle @ turn expressed by a fixed point number.
     \param [in] deg A real number of a degree.
     \param [in] bit_width The bit-width of the return value. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
     \return The angle @ turn expressed by a fixed point of the 0 bit integer part and bit_width bit decimal place. It means the angle as an integer is in range [0, 2**bit_width - 1], that is [0, 1) turn = [0, 360) degree.
+
+    A negative or out of range degree is reduced by fmod(deg, 360.0) and adding 360 if it's negative, so -90 is the same as 270 at any bit-width.
 */
 extern unsigned int conv_deg_to_turn(double deg, unsigned int bit_width);
 
+/** Convert some degrees to angles @ turn at once.
+    \param [in] degs Real numbers of degrees.
+    \param [in] num The number of the degrees in degs.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [out] turns The angles @ turn. The length must be at least num.
+
+    turns[i] is the same as conv_deg_to_turn(degs[i], bit_width). This function converts 8 or 4 degrees at once by AVX-512 or AVX2 if the compiler enables them; it reduces a degree as fmod(deg, 360.0) without calling fmod() if the absolute value is less than 2**52.
+*/
+extern void conv_degs_to_turns(const double *degs, size_t num, unsigned int bit_width, unsigned int *turns);
+
+/** The maximum number of the tasks of the parallel batch functions. */
+#define SERDES_TURN_DEG_MAX_TASKS 256
+
+/** A task of the parallel batch functions.
+    \param [inout] task_arg The argument that the parallel batch function gives to the executor.
+    \param [in] index The index of the task in range [0, num_of_tasks).
+*/
+typedef void (*serdes_turn_deg_task)(void *task_arg, size_t index);
+
+/** An executor that runs the tasks of the parallel batch functions, such as a wrapper of a thread pool.
+    \param [inout] context The context that the caller gives to the parallel batch function.
+    \param [in] num_of_tasks The number of the tasks.
+    \param [in] task The function of the tasks.
+    \param [inout] task_arg The argument of task.
+
+    The executor must call task(task_arg, i) once for each i in [0, num_of_tasks) and return after all of them return. The tasks write to the different memory, so they may run on any threads in any order at the same time.
+*/
+typedef void (*serdes_turn_deg_executor)(void *context, size_t num_of_tasks, serdes_turn_deg_task task, void *task_arg);
+
+/** The parallel variation of serialize_turns_to_deg(), serialize_turns_to_deg_p(), and serialize_turns_to_deg_ps().
+    \param [inout] buf A buffer to write the serialized strings. The length must be at least SERDES_TURN_DEG_BATCH_BUF_SIZE(num).
+    \param [in] turns The angles @ turn.
+    \param [in] num The number of the angles in turns.
+    \param [in] bit_width The bit-width of turns. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \param [in] mode The serialize function to run in parallel.
+    \param [in] precision The same as serialize_turn_to_deg_length().
+    \param [in] separator The character to put between the serialized strings.
+    \param [in] num_of_tasks The number of the tasks to split turns into, such as the number of the threads. It must be in range [1, SERDES_TURN_DEG_MAX_TASKS].
+    \param [in] executor The executor to run the tasks, or NULL.
+    \param [inout] context The context of executor.
+    \return The point to NUL character in buf.
+
+    The string in buf is the same as the batch serialize function of mode writes. Each task serializes its own range of turns into its own region of buf, and then the regions are concatenated in order at the prefix sum of their lengths, so buf needs SERDES_TURN_DEG_BATCH_BUF_SIZE(num) even if the total length is known by serialize_turns_to_deg_length(). If bit_width is more than SERDES_TURN_DEG_MAX_BIT_WIDTH or precision of SERDES_TURN_DEG_MODE_P and SERDES_TURN_DEG_MODE_PS is more than SERDES_TURN_DEG_MAX_PRECISION, buf needs SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num) instead.
+
+    If executor is NULL, the tasks run on the threads that this function creates if the library is built with SERDES_TURN_DEG_PTHREAD, or on the calling thread one after another otherwise. This function makes fewer tasks than num_of_tasks for a small num, and runs a single task without executor.
+*/
+extern char *serialize_turns_to_deg_parallel(char *buf, const unsigned int *turns, size_t num, unsigned int bit_width, enum serdes_turn_deg_mode mode, int precision, char separator, size_t num_of_tasks, serdes_turn_deg_executor executor, void *context);
+
+/** The parallel variation of deserialize_turns_from_deg().
+    \param [in] serialized_degs The same as deserialize_turns_from_deg().
+    \param [in] len The same as deserialize_turns_from_deg().
+    \param [in] separator The same as deserialize_turns_from_deg().
+    \param [in] bit_width The same as deserialize_turns_from_deg().
+    \param [out] turns The same as deserialize_turns_from_deg().
+    \param [in] max_num The same as deserialize_turns_from_deg().
+    \param [out] endptrs The same as deserialize_turns_from_deg().
+    \param [out] next The same as deserialize_turns_from_deg().
+    \param [in] num_of_tasks The number of the tasks to split serialized_degs into. It must be in range [1, SERDES_TURN_DEG_MAX_TASKS].
+    \param [in] executor The same as serialize_turns_to_deg_parallel().
+    \param [inout] context The context of executor.
+    \return The number of the deserialized real numbers.
+
+    The results are the same as deserialize_turns_from_deg(). serialized_degs is split after the separators, and the tasks run twice: the first counts the fields of each part to know where its angles go in turns by the prefix sum, and the second deserializes them. The executor and the threads are the same as serialize_turns_to_deg_parallel().
+*/
+extern size_t deserialize_turns_from_deg_parallel(const char *serialized_degs, size_t len, char separator, unsigned int bit_width, unsigned int *turns, size_t max_num, const char **endptrs, const char **next, size_t num_of_tasks, serdes_turn_deg_executor executor, void *context);
+
+/** Get the statistics of the calls in the current thread.
+    \param [out] stats The statistics since the thread started or serdes_turn_deg_reset_stats() was called.
+    \return 1 if the library collects the statistics, or 0 if it doesn't; stats is filled with 0 in this case.
+
+    The library collects the statistics only if it is built with SERDES_TURN_DEG_STATS. Each thread has its own counters, so call this function in each thread to know the whole. The tables of the serialized strings don't count the carries and the suppressions.
+*/
+extern int serdes_turn_deg_get_stats(struct serdes_turn_deg_stats *stats);
+
+/** Reset the statistics of the calls in the current thread to 0. */
+extern void serdes_turn_deg_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* SERDES_TURN_DEG_H_ */
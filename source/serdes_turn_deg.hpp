@@ -0,0 +1,556 @@
+/** C++ interface of serdes_turn_deg specialized on the bit-width and the precision at compile time.
+    \file serdes_turn_deg.hpp
+    \author OOTA, Masato
+    \copyright Copyright © 2023 OOTA, Masato
+    \par License GPL-3.0-or-later
+    \parblock
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+    \endparblock
+
+    This header needs C++17. The serialize functions are header-only and constexpr, so they can serialize a constant angle at compile time. They return the same strings as serialize_turn_to_deg(), serialize_turn_to_deg_p(), and serialize_turn_to_deg_ps().
+
+    to_chars() and from_chars() have the interface of std::to_chars() and std::from_chars(): they write to or read from [first, last), return the end pointer and std::errc, never allocate, and never need NUL. They call the library at run time, and to_chars() generates the digits in this header only in the constant evaluation. The overloads that take the bit-width and the precision at run time also call the library. The overloads for std::span are available if the standard library has std::span.
+*/
+#ifndef SERDES_TURN_DEG_HPP_
+#define SERDES_TURN_DEG_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+#include "serdes_turn_deg.h"
+
+namespace serdes_turn {
+
+/** A serialized string, which is terminated by NUL. */
+struct deg_string {
+    char buf[SERDES_TURN_DEG_WIDE_BUF_SIZE] = {}; /**< The string terminated by NUL. */
+    std::size_t len = 0; /**< The length of the string. */
+
+    constexpr const char *c_str() const noexcept { return buf; }
+    constexpr const char *data() const noexcept { return buf; }
+    constexpr std::size_t size() const noexcept { return len; }
+    constexpr std::string_view view() const noexcept { return std::string_view(buf, len); }
+
+    /** Compare with a string terminated by NUL. */
+    constexpr bool equals(const char *str) const noexcept
+    {
+        std::size_t i = 0;
+        for (; i < len; i++) {
+            if (buf[i] != str[i]) {
+                return false;
+            }
+        }
+        return str[i] == '\0';
+    }
+};
+
+namespace detail {
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the C library accepts in this build. */
+constexpr unsigned int max_bit_width = SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH;
+/** The maximum precision that the C library accepts in this build. */
+constexpr int max_precision = SERDES_TURN_DEG_WIDE_MAX_PRECISION;
+#else
+constexpr unsigned int max_bit_width = SERDES_TURN_DEG_MAX_BIT_WIDTH;
+constexpr int max_precision = SERDES_TURN_DEG_MAX_PRECISION;
+#endif
+
+/** The maximum place of digit. */
+constexpr int max_place = -SERDES_TURN_DEG_MIN_PRECISION;
+/** The minimum place of digit. */
+constexpr int min_place = -max_precision;
+/** The length of a digit array. */
+constexpr int num_of_places = max_place - min_place + 1;
+
+/** The index that is equivalent the place\#k. */
+constexpr int buf_index(const int k) noexcept { return max_place - k; }
+
+/** The constants of the digit generation, which the compiler folds for BitWidth. */
+template <unsigned int BitWidth>
+struct digit_params {
+    static_assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= BitWidth && BitWidth <= detail::max_bit_width, "BitWidth is out of range");
+
+    /** The narrow type is enough if R * 10 doesn't overflow, same as the C library. */
+    using uint = std::conditional_t<(BitWidth <= 22), std::uint32_t, std::uint64_t>;
+
+    static constexpr uint mask = static_cast<uint>((std::uint64_t(1) << BitWidth) - 1);
+    static constexpr uint S = static_cast<uint>(std::uint64_t(100) << BitWidth); /* 100 degree */
+};
+
+/** Convert an angle @ turn to the digit array @ degree. The same as conv_turn_to_deg_digit_array() in serdes_turn_deg.c.
+    \return The minimum place of digit to output.
+*/
+template <unsigned int BitWidth>
+constexpr int conv_turn_to_deg_digit_array(char *digits, const unsigned int turn, const int place) noexcept
+{
+    using params = digit_params<BitWidth>;
+    using uint = typename params::uint;
+    constexpr uint S = params::S;
+    uint R = static_cast<uint>(turn & params::mask) * 360;
+    uint M = 180;
+    bool low = false;
+    bool high = false;
+    int k = max_place + 1;
+    while (!low && !high && k > min_place) {
+        uint U = R / S;
+        k--;
+        R -= U * S;
+        if (k <= place) {
+            low = R < M;
+            high = R + M > S;
+            if (high && (!low || R >= S / 2)) {
+                U++;
+            }
+        }
+        digits[buf_index(k)] = static_cast<char>(U);
+        R *= 10;
+        M *= 10;
+        if (M > S) {
+            M = S;
+        }
+    }
+    return k;
+}
+
+/** Carry up an overflow from the lowest place. */
+constexpr void carry_up_overflow(char *digits, const int lowest_place) noexcept
+{
+    for (int k = lowest_place; k < max_place; k++) {
+        if (digits[buf_index(k)] != 10) {
+            break;
+        }
+        digits[buf_index(k)] = 0;
+        digits[buf_index(k + 1)]++;
+    }
+}
+
+/** Convert a digit array @ degree to the characters without NUL.
+    \return The point to the next of the last character in dest.
+*/
+constexpr char *conv_deg_digit_array_to_chars(char *dest, const char *src, const int lowest_place) noexcept
+{
+    char *const dest_begin = dest;
+    int k = max_place;
+    for (; k >= lowest_place; k--) {
+        if (k > 0 && *src == 0 && dest == dest_begin) {
+            /* Zero suppress */
+            src++;
+            continue;
+        }
+        if (k == -1) {
+            *dest++ = '.';
+        }
+        *dest++ = static_cast<char>('0' + *src++);
+    }
+    if (dest == dest_begin) {
+        *dest++ = '0';
+    } else {
+        /* The integer part needs to be filled with '0'. */
+        for (; k >= 0; k--) {
+            *dest++ = '0';
+        }
+    }
+    return dest;
+}
+
+/** Convert a digit array @ degree to the string.
+    \return The point to NUL character in dest.
+*/
+constexpr char *conv_deg_digit_array_to_string(char *dest, const char *src, const int lowest_place) noexcept
+{
+    dest = conv_deg_digit_array_to_chars(dest, src, lowest_place);
+    *dest = '\0';
+    return dest;
+}
+
+enum class kind { shortest, p, ps };
+
+/** Serialize an angle to the characters without NUL.
+    \return The point to the next of the last character in buf.
+*/
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr char *serialize_chars(char *buf, const unsigned int turn) noexcept
+{
+    char digits[num_of_places] = {};
+    int lowest_place = conv_turn_to_deg_digit_array<BitWidth>(digits, turn, Place);
+    if constexpr (Kind != kind::shortest) {
+        carry_up_overflow(digits, lowest_place);
+    }
+    if constexpr (Kind == kind::ps) {
+        /* suppress lower zero */
+        while (lowest_place < 0 && digits[buf_index(lowest_place)] == 0) {
+            lowest_place++;
+        }
+    }
+    return conv_deg_digit_array_to_chars(buf, digits, lowest_place);
+}
+
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr char *serialize(char *buf, const unsigned int turn) noexcept
+{
+    char *const end = serialize_chars<BitWidth, Kind, Place>(buf, turn);
+    *end = '\0';
+    return end;
+}
+
+template <int Precision>
+constexpr void check_precision() noexcept
+{
+    static_assert(SERDES_TURN_DEG_MIN_PRECISION <= Precision && Precision <= max_precision, "Precision is out of range");
+}
+
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr deg_string serialize(const unsigned int turn) noexcept
+{
+    deg_string str;
+    str.len = static_cast<std::size_t>(serialize<BitWidth, Kind, Place>(str.buf, turn) - str.buf);
+    return str;
+}
+
+/** The buffer length for BitWidth and Place. */
+constexpr std::ptrdiff_t buf_size(const unsigned int bit_width, const int place) noexcept
+{
+    return bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH && place >= -SERDES_TURN_DEG_MAX_PRECISION ? SERDES_TURN_DEG_BUF_SIZE : SERDES_TURN_DEG_WIDE_BUF_SIZE;
+}
+
+/** Whether the call is in the constant evaluation. It's always true if the compiler can't tell, so that constexpr still works. */
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+#else
+    return true;
+#endif
+}
+
+/** Serialize an angle by the C library.
+    \return The point to NUL character in buf.
+*/
+inline char *serialize_c(char *buf, const unsigned int turn, const unsigned int bit_width, const kind k, const int place) noexcept
+{
+    switch (k) {
+    case kind::shortest:
+        return serialize_turn_to_deg(buf, turn, bit_width);
+    case kind::p:
+        return serialize_turn_to_deg_p(buf, turn, bit_width, -place);
+    default:
+        return serialize_turn_to_deg_ps(buf, turn, bit_width, -place);
+    }
+}
+
+/** to_chars() by the C library for the bit-width and the place at run time. */
+inline std::to_chars_result to_chars_c(char *first, char *last, const unsigned int turn, const unsigned int bit_width, const kind k, const int place) noexcept
+{
+    if (last - first >= buf_size(bit_width, place)) {
+        /* The longest string and NUL fit, so no copy is needed. */
+        return { serialize_c(first, turn, bit_width, k, place), std::errc() };
+    }
+    char buf[SERDES_TURN_DEG_WIDE_BUF_SIZE];
+    const std::ptrdiff_t len = serialize_c(buf, turn, bit_width, k, place) - buf;
+    if (len > last - first) {
+        return { last, std::errc::value_too_large };
+    }
+    std::memcpy(first, buf, static_cast<std::size_t>(len));
+    return { first + len, std::errc() };
+}
+
+/** to_chars() in the constant evaluation, which generates the digits in this header. */
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr std::to_chars_result to_chars_constexpr(char *first, char *last, const unsigned int turn) noexcept
+{
+    if (last - first >= buf_size(BitWidth, Place) - 1) {
+        /* The longest string fits, so no copy is needed. */
+        return { serialize_chars<BitWidth, Kind, Place>(first, turn), std::errc() };
+    }
+    char buf[SERDES_TURN_DEG_WIDE_BUF_SIZE] = {};
+    const char *const end = serialize_chars<BitWidth, Kind, Place>(buf, turn);
+    if (end - buf > last - first) {
+        return { last, std::errc::value_too_large };
+    }
+    for (const char *src = buf; src != end; src++) {
+        *first++ = *src;
+    }
+    return { first, std::errc() };
+}
+
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr std::to_chars_result to_chars(char *first, char *last, const unsigned int turn) noexcept
+{
+    if (is_constant_evaluated()) {
+        return to_chars_constexpr<BitWidth, Kind, Place>(first, last, turn);
+    }
+    return to_chars_c(first, last, turn, BitWidth, Kind, Place);
+}
+
+#ifdef __cpp_lib_span
+template <unsigned int BitWidth, kind Kind, int Place>
+constexpr std::to_chars_result to_chars(char *first, char *last, const std::span<const unsigned int> turns, const char separator) noexcept
+{
+    for (std::size_t i = 0; i < turns.size(); i++) {
+        if (i > 0) {
+            if (first == last) {
+                return { last, std::errc::value_too_large };
+            }
+            *first++ = separator;
+        }
+        const std::to_chars_result result = to_chars<BitWidth, Kind, Place>(first, last, turns[i]);
+        if (result.ec != std::errc()) {
+            return result;
+        }
+        first = result.ptr;
+    }
+    return { first, std::errc() };
+}
+#endif
+
+} // namespace detail
+
+/** The same as serialize_turn_to_deg().
+    \tparam BitWidth The bit-width of turn.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \return The point to NUL character in buf.
+*/
+template <unsigned int BitWidth>
+constexpr char *serialize(char *buf, const unsigned int turn) noexcept
+{
+    return detail::serialize<BitWidth, detail::kind::shortest, detail::max_place>(buf, turn);
+}
+
+/** The same as serialize_turn_to_deg(), but returns the string. */
+template <unsigned int BitWidth>
+constexpr deg_string serialize(const unsigned int turn) noexcept
+{
+    return detail::serialize<BitWidth, detail::kind::shortest, detail::max_place>(turn);
+}
+
+/** The same as serialize_turn_to_deg_p().
+    \tparam BitWidth The bit-width of turn.
+    \tparam Precision The minimum digit number after the decimal point.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \return The point to NUL character in buf.
+*/
+template <unsigned int BitWidth, int Precision>
+constexpr char *serialize_p(char *buf, const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::serialize<BitWidth, detail::kind::p, -Precision>(buf, turn);
+}
+
+/** The same as serialize_turn_to_deg_p(), but returns the string. */
+template <unsigned int BitWidth, int Precision>
+constexpr deg_string serialize_p(const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::serialize<BitWidth, detail::kind::p, -Precision>(turn);
+}
+
+/** The same as serialize_turn_to_deg_ps().
+    \tparam BitWidth The bit-width of turn.
+    \tparam Precision The minimum digit number after the decimal point.
+    \param [inout] buf A buffer to write a serialized string. The length must be at least SERDES_TURN_DEG_BUF_SIZE.
+    \param [in] turn The angle @ turn.
+    \return The point to NUL character in buf.
+*/
+template <unsigned int BitWidth, int Precision>
+constexpr char *serialize_ps(char *buf, const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::serialize<BitWidth, detail::kind::ps, -Precision>(buf, turn);
+}
+
+/** The same as serialize_turn_to_deg_ps(), but returns the string. */
+template <unsigned int BitWidth, int Precision>
+constexpr deg_string serialize_ps(const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::serialize<BitWidth, detail::kind::ps, -Precision>(turn);
+}
+
+/** The same as serialize_turn_to_deg(), but in the way of std::to_chars().
+    \tparam BitWidth The bit-width of turn.
+    \param [out] first The beginning of the buffer.
+    \param [in] last The end of the buffer.
+    \param [in] turn The angle @ turn.
+    \return {the end of the string, std::errc()}, or {last, std::errc::value_too_large} if the buffer is too short. The string isn't terminated by NUL.
+
+    At run time, serialize_turn_to_deg() writes the string and NUL directly if the buffer has SERDES_TURN_DEG_BUF_SIZE characters (SERDES_TURN_DEG_WIDE_BUF_SIZE if BitWidth or the precision is out of the classic range), and into a local buffer to copy otherwise. So the characters after the end aren't written except that NUL. In the constant evaluation, the digits are generated in this header and nothing is written after the end.
+*/
+template <unsigned int BitWidth>
+constexpr std::to_chars_result to_chars(char *first, char *last, const unsigned int turn) noexcept
+{
+    return detail::to_chars<BitWidth, detail::kind::shortest, detail::max_place>(first, last, turn);
+}
+
+/** The same as serialize_turn_to_deg_p(), but in the way of std::to_chars(). See to_chars(). */
+template <unsigned int BitWidth, int Precision>
+constexpr std::to_chars_result to_chars_p(char *first, char *last, const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::to_chars<BitWidth, detail::kind::p, -Precision>(first, last, turn);
+}
+
+/** The same as serialize_turn_to_deg_ps(), but in the way of std::to_chars(). See to_chars(). */
+template <unsigned int BitWidth, int Precision>
+constexpr std::to_chars_result to_chars_ps(char *first, char *last, const unsigned int turn) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::to_chars<BitWidth, detail::kind::ps, -Precision>(first, last, turn);
+}
+
+/** The same as to_chars(), but takes the bit-width at run time.
+    \param [out] first The beginning of the buffer.
+    \param [in] last The end of the buffer.
+    \param [in] turn The angle @ turn.
+    \param [in] bit_width The bit-width of turn. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH].
+    \return The same as to_chars().
+*/
+inline std::to_chars_result to_chars(char *first, char *last, const unsigned int turn, const unsigned int bit_width) noexcept
+{
+    return detail::to_chars_c(first, last, turn, bit_width, detail::kind::shortest, detail::max_place);
+}
+
+/** The same as to_chars_p(), but takes the bit-width and the precision at run time. The precision must be in range [SERDES_TURN_DEG_MIN_PRECISION, SERDES_TURN_DEG_MAX_PRECISION]. */
+inline std::to_chars_result to_chars_p(char *first, char *last, const unsigned int turn, const unsigned int bit_width, const int precision) noexcept
+{
+    return detail::to_chars_c(first, last, turn, bit_width, detail::kind::p, -precision);
+}
+
+/** The same as to_chars_ps(), but takes the bit-width and the precision at run time. See to_chars_p(). */
+inline std::to_chars_result to_chars_ps(char *first, char *last, const unsigned int turn, const unsigned int bit_width, const int precision) noexcept
+{
+    return detail::to_chars_c(first, last, turn, bit_width, detail::kind::ps, -precision);
+}
+
+/** The same as from_chars<BitWidth>(), but takes the bit-width at run time. It must be in range [SERDES_TURN_DEG_MIN_BIT_WIDTH, SERDES_TURN_DEG_MAX_BIT_WIDTH]. */
+inline std::from_chars_result from_chars(const char *first, const char *last, unsigned int &turn, const unsigned int bit_width) noexcept
+{
+    std::size_t consumed = 0;
+    switch (deserialize_turn_from_deg_n(first, static_cast<std::size_t>(last - first), bit_width, &turn, &consumed)) {
+    case SERDES_TURN_DEG_SUCCESS:
+        return { first + consumed, std::errc() };
+    case SERDES_TURN_DEG_ERR_OUT_OF_RANGE:
+        return { first + consumed, std::errc::result_out_of_range };
+    default:
+        return { first, std::errc::invalid_argument };
+    }
+}
+
+/** The same as deserialize_turn_from_deg_n(), but in the way of std::from_chars().
+    \tparam BitWidth The bit-width of turn.
+    \param [in] first The beginning of the text.
+    \param [in] last The end of the text.
+    \param [out] turn The angle @ turn if the result is std::errc(). It's unchanged if the result is an error.
+    \return {the end of the degree, std::errc()}, {first, std::errc::invalid_argument} if the text has no digits, or {the digit after the integer part, std::errc::result_out_of_range} if the integer part is too long.
+
+    The text is the same as deserialize_turn_from_deg_n() accepts, so the white spaces before the degree are skipped unlike std::from_chars().
+*/
+template <unsigned int BitWidth>
+inline std::from_chars_result from_chars(const char *first, const char *last, unsigned int &turn) noexcept
+{
+    static_assert(SERDES_TURN_DEG_MIN_BIT_WIDTH <= BitWidth && BitWidth <= detail::max_bit_width, "BitWidth is out of range");
+    return from_chars(first, last, turn, BitWidth);
+}
+
+#ifdef __cpp_lib_span
+/** The same as serialize_turns_to_deg(), but in the way of std::to_chars().
+    \tparam BitWidth The bit-width of turns.
+    \param [out] first The beginning of the buffer.
+    \param [in] last The end of the buffer.
+    \param [in] turns The angles @ turn.
+    \param [in] separator The character to put between the strings.
+    \return {the end of the strings, std::errc()}, or {last, std::errc::value_too_large} if the buffer is too short. The strings aren't terminated by NUL.
+*/
+template <unsigned int BitWidth>
+constexpr std::to_chars_result to_chars(char *first, char *last, const std::span<const unsigned int> turns, const char separator) noexcept
+{
+    return detail::to_chars<BitWidth, detail::kind::shortest, detail::max_place>(first, last, turns, separator);
+}
+
+/** The same as serialize_turns_to_deg_p(), but in the way of std::to_chars(). See to_chars() of std::span. */
+template <unsigned int BitWidth, int Precision>
+constexpr std::to_chars_result to_chars_p(char *first, char *last, const std::span<const unsigned int> turns, const char separator) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::to_chars<BitWidth, detail::kind::p, -Precision>(first, last, turns, separator);
+}
+
+/** The same as serialize_turns_to_deg_ps(), but in the way of std::to_chars(). See to_chars() of std::span. */
+template <unsigned int BitWidth, int Precision>
+constexpr std::to_chars_result to_chars_ps(char *first, char *last, const std::span<const unsigned int> turns, const char separator) noexcept
+{
+    detail::check_precision<Precision>();
+    return detail::to_chars<BitWidth, detail::kind::ps, -Precision>(first, last, turns, separator);
+}
+
+/** The result of from_chars() of std::span. */
+struct from_chars_turns_result {
+    const char *ptr; /**< The same as std::from_chars_result::ptr. */
+    std::errc ec; /**< The same as std::from_chars_result::ec. */
+    std::size_t num; /**< The number of the deserialized angles. */
+};
+
+/** Deserialize the degrees separated by a character as same as deserialize_turns_from_deg(), but in the way of std::from_chars().
+    \tparam BitWidth The bit-width of turns.
+    \param [in] first The beginning of the text.
+    \param [in] last The end of the text.
+    \param [out] turns The angles @ turn. The number of the fields to deserialize is up to its size.
+    \param [in] separator The character between the degrees.
+    \return {the first field not deserialized or last, std::errc(), the number of the fields} if all fields are degrees, or {the pointer that from_chars() returns, its error, the number of the fields before} at the first malformed field. A field that has the characters after the degree is std::errc::invalid_argument, and ptr points to them.
+*/
+template <unsigned int BitWidth>
+inline from_chars_turns_result from_chars(const char *first, const char *last, const std::span<unsigned int> turns, const char separator) noexcept
+{
+    std::size_t i = 0;
+    for (; i < turns.size() && first != last; i++) {
+        const char *field_end = std::char_traits<char>::find(first, static_cast<std::size_t>(last - first), separator);
+        if (field_end == nullptr) {
+            field_end = last;
+        }
+        const std::from_chars_result result = from_chars<BitWidth>(first, field_end, turns[i]);
+        if (result.ec != std::errc()) {
+            return { result.ptr, result.ec, i };
+        }
+        if (result.ptr != field_end) {
+            return { result.ptr, std::errc::invalid_argument, i };
+        }
+        /* skip the separator */
+        first = field_end == last ? last : field_end + 1;
+    }
+    return { first, std::errc(), i };
+}
+#endif
+
+} // namespace serdes_turn
+
+#endif /* SERDES_TURN_DEG_HPP_ */
@@ -15,17 +15,24 @@
   You should have received a copy of the GNU General Public License
   along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #include "serdes_turn_deg.h"
 
 #define ERROR(error_msg, ...) \
     do { \
+        flockfile(stdout); \
         printf("Error in %s() (%s:%u): " error_msg ": ", __func__, __FILE__, __LINE__); \
         ERR_PARAM(__VA_ARGS__); \
         fputc('\n', stdout); \
+        funlockfile(stdout); \
     } while (0)
 
 #define INDEX_SEQ2 6, 6, 5, 5, 4, 4, 3, 3, 2, 2, 1, 1
@@ -53,16 +60,60 @@
     ERR_PARAM_5(msg1, var1, msg2, var2, msg3, var3, msg4, var4, msg5, var5); \
     printf(", " msg6, var6)
 
+#define NUM_OF(a) (sizeof(a)/sizeof(a[0]))
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the library accepts in this build. */
+#define TEST_MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the library accepts in this build. */
+#define TEST_MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length for TEST_MAX_BIT_WIDTH and TEST_MAX_PRECISION. */
+#define TEST_BUF_SIZE SERDES_TURN_DEG_WIDE_BUF_SIZE
+#else
+#define TEST_MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define TEST_MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define TEST_BUF_SIZE SERDES_TURN_DEG_BUF_SIZE
+#endif
+/** The buffer length that the document requires to serialize num angles at once: SERDES_TURN_DEG_BATCH_BUF_SIZE(num) within the public limits, and SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num) otherwise. precision is 0 for the shortest. */
+#define TEST_BATCH_BUF_SIZE(num, bit_width, precision) \
+    (((bit_width) > SERDES_TURN_DEG_MAX_BIT_WIDTH || (precision) > SERDES_TURN_DEG_MAX_PRECISION) ? SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num) : SERDES_TURN_DEG_BATCH_BUF_SIZE(num))
+
+/** The maximum bit-width to test all turns. */
+#define TEST_MAX_EXHAUSTIVE_BIT_WIDTH 22
+/** The number of the turns to test in a bit-width more than TEST_MAX_EXHAUSTIVE_BIT_WIDTH. */
+#define TEST_NUM_OF_SAMPLE_TURNS (1ul << 16)
 
-int test_recoverable_serialize_turn_to_deg(const unsigned int bit_width)
+
+unsigned long num_of_test_turns(const unsigned int bit_width)
 {
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
-    unsigned int i;
-    for (i = 0; i < 1u << bit_width; i++) {
+    return bit_width <= TEST_MAX_EXHAUSTIVE_BIT_WIDTH ? 1ul << bit_width : TEST_NUM_OF_SAMPLE_TURNS;
+}
+
+unsigned int test_turn(const unsigned long n, const unsigned int bit_width)
+{
+    unsigned long step;
+    if (bit_width <= TEST_MAX_EXHAUSTIVE_BIT_WIDTH) {
+        return n;
+    }
+    if (n == TEST_NUM_OF_SAMPLE_TURNS - 1) {
+        return (unsigned int)((1ul << bit_width) - 1);
+    }
+    /* Spread the samples over the whole range, and vary the lower bits. */
+    step = (1ul << bit_width) / TEST_NUM_OF_SAMPLE_TURNS;
+    return (unsigned int)(n * step + (n * 2654435761ul) % step);
+}
+
+
+int test_recoverable_serialize_turn_to_deg(const unsigned int bit_width, const unsigned long begin, const unsigned long end)
+{
+    char buf[TEST_BUF_SIZE];
+    unsigned long n;
+    for (n = begin; n < end; n++) {
+        const unsigned int i = test_turn(n, bit_width);
         double deg;
         unsigned int recovered;
         const char *end_ptr = serialize_turn_to_deg(buf, i, bit_width);
-        if (end_ptr - buf >= SERDES_TURN_DEG_BUF_SIZE) {
+        if (end_ptr - buf >= (bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH ? SERDES_TURN_DEG_BUF_SIZE : TEST_BUF_SIZE)) {
             ERROR("Buffer overflow?",
                   "bit_width: %u", bit_width,
                   "turn: %u", i,
@@ -99,11 +150,12 @@ int test_recoverable_serialize_turn_to_deg(const unsigned int bit_width)
     return 1;
 }
 
-int test_recoverable_serialize_turn_to_deg_p(const unsigned int bit_width, const int precision)
+int test_recoverable_serialize_turn_to_deg_p(const unsigned int bit_width, const int precision, const unsigned long begin, const unsigned long end)
 {
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
-    unsigned int i;
-    for (i = 0; i < 1u << bit_width; i++) {
+    char buf[TEST_BUF_SIZE];
+    unsigned long n;
+    for (n = begin; n < end; n++) {
+        const unsigned int i = test_turn(n, bit_width);
         double deg;
         unsigned int recovered;
         const char *end_ptr = serialize_turn_to_deg_p(buf, i, bit_width, precision);
@@ -157,12 +209,13 @@ int test_recoverable_serialize_turn_to_deg_p(const unsigned int bit_width, const
     return 1;
 }
 
-int test_recoverable_serialize_turn_to_deg_ps(const unsigned int bit_width, const int precision)
+int test_recoverable_serialize_turn_to_deg_ps(const unsigned int bit_width, const int precision, const unsigned long begin, const unsigned long end)
 {
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
-    char buf2[SERDES_TURN_DEG_BUF_SIZE];
-    unsigned int i;
-    for (i = 0; i < 1u << bit_width; i++) {
+    char buf[TEST_BUF_SIZE];
+    char buf2[TEST_BUF_SIZE];
+    unsigned long n;
+    for (n = begin; n < end; n++) {
+        const unsigned int i = test_turn(n, bit_width);
         double deg;
         unsigned int recovered;
         const char *end_ptr = serialize_turn_to_deg_ps(buf, i, bit_width, precision);
@@ -248,6 +301,308 @@ int test_recoverable_serialize_turn_to_deg_ps(const unsigned int bit_width, cons
 }
 
 
+int test_recoverable_serialize_turn_to_deg_fixed(const unsigned int bit_width, const unsigned long begin, const unsigned long end)
+{
+    const char pads[] = { ' ', '0' };
+    const int min_precision = deg_fixed_min_precision(bit_width);
+    int precision;
+    for (precision = min_precision; precision <= TEST_MAX_PRECISION; precision++) {
+        const int width = SERDES_TURN_DEG_FIXED_WIDTH(precision);
+        unsigned long n;
+        for (n = begin; n < end; n++) {
+            const unsigned int i = test_turn(n, bit_width);
+            char expected[TEST_BUF_SIZE];
+            const int expected_len = serialize_turn_to_deg_p(expected, i, bit_width, precision) - expected;
+            size_t j;
+            for (j = 0; j < NUM_OF(pads); j++) {
+                char buf[TEST_BUF_SIZE];
+                const char *const end_ptr = serialize_turn_to_deg_fixed(buf, i, bit_width, precision, pads[j]);
+                int k;
+                unsigned int recovered;
+                if (end_ptr - buf != width || *end_ptr != '\0' || expected_len > width) {
+                    ERROR("Invalid width",
+                          "bit_width: %u", bit_width,
+                          "precision: %d", precision,
+                          "turn: %u", i,
+                          "serialized deg: \"%s\"", buf,
+                          "serialized deg by serialize_turn_to_deg_p(): %s", expected);
+                    return 0;
+                }
+                for (k = 0; k < width - expected_len; k++) {
+                    if (buf[k] != pads[j]) {
+                        break;
+                    }
+                }
+                if (k != width - expected_len || strcmp(buf + k, expected) != 0) {
+                    ERROR("Not the same as serialize_turn_to_deg_p()",
+                          "bit_width: %u", bit_width,
+                          "precision: %d", precision,
+                          "turn: %u", i,
+                          "serialized deg: \"%s\"", buf,
+                          "serialized deg by serialize_turn_to_deg_p(): %s", expected);
+                    return 0;
+                }
+                recovered = deserialize_turn_from_deg_fixed(buf, bit_width, precision);
+                if (i != recovered) {
+                    ERROR("Deserialized turn mismatch",
+                          "bit_width: %u", bit_width,
+                          "precision: %d", precision,
+                          "turn: %u", i,
+                          "serialized deg: \"%s\"", buf,
+                          "recovered turn: %u", recovered);
+                    return 0;
+                }
+                recovered = deserialize_turn_from_deg(buf, bit_width, NULL);
+                if (i != recovered) {
+                    ERROR("Deserialized turn mismatch by deserialize_turn_from_deg()",
+                          "bit_width: %u", bit_width,
+                          "precision: %d", precision,
+                          "turn: %u", i,
+                          "serialized deg: \"%s\"", buf,
+                          "recovered turn: %u", recovered);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+int test_deg_fixed_min_precision()
+{
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        const int precision = deg_fixed_min_precision(bit_width);
+        /* 10**precision > 2**bit_width / 360 >= 10**(precision - 1) */
+        double scale = 1.0;
+        int i;
+        for (i = 0; i < (precision >= 0 ? precision : -precision); i++) {
+            scale *= 10.0;
+        }
+        if (precision < 0) {
+            scale = 1.0 / scale;
+        }
+        if (!(360.0 * scale > (double)(1ul << bit_width) && 360.0 * scale / 10.0 <= (double)(1ul << bit_width))) {
+            ERROR("Invalid minimum precision",
+                  "bit_width: %u", bit_width,
+                  "precision: %d", precision);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+int test_serialize_turns_to_deg(const unsigned int bit_width, const int precision)
+{
+    const size_t num = 1u << bit_width;
+    unsigned int *turns = malloc(num * sizeof(turns[0]));
+    char *batch_buf = malloc(TEST_BATCH_BUF_SIZE(num, bit_width, precision));
+    char buf[TEST_BUF_SIZE];
+    int success = 1;
+    int mode;
+    size_t i;
+    if (turns == NULL || batch_buf == NULL) {
+        ERROR("Out of memory",
+              "bit_width: %u", bit_width);
+        free(turns);
+        free(batch_buf);
+        return 0;
+    }
+    for (i = 0; i < num; i++) {
+        /* reverse order to avoid a sequential pattern. */
+        turns[i] = (unsigned int)(num - 1 - i);
+    }
+    for (mode = 0; mode < 3 && success; mode++) {
+        const char *p = batch_buf;
+        const char *end_ptr;
+        switch (mode) {
+        case 0:
+            end_ptr = serialize_turns_to_deg(batch_buf, turns, num, bit_width, ',');
+            break;
+        case 1:
+            end_ptr = serialize_turns_to_deg_p(batch_buf, turns, num, bit_width, precision, ',');
+            break;
+        default:
+            end_ptr = serialize_turns_to_deg_ps(batch_buf, turns, num, bit_width, precision, ',');
+            break;
+        }
+        for (i = 0; i < num; i++) {
+            size_t len;
+            switch (mode) {
+            case 0:
+                len = serialize_turn_to_deg(buf, turns[i], bit_width) - buf;
+                break;
+            case 1:
+                len = serialize_turn_to_deg_p(buf, turns[i], bit_width, precision) - buf;
+                break;
+            default:
+                len = serialize_turn_to_deg_ps(buf, turns[i], bit_width, precision) - buf;
+                break;
+            }
+            if (strncmp(p, buf, len) != 0 || p[len] != (i + 1 < num ? ',' : '\0')) {
+                ERROR("Batch result mismatch",
+                      "mode: %d", mode,
+                      "bit_width: %u", bit_width,
+                      "precision: %d", precision,
+                      "turn: %u", turns[i],
+                      "expected deg: %s", buf);
+                success = 0;
+                break;
+            }
+            p += len + 1;
+        }
+        if (success && end_ptr != p - 1) {
+            ERROR("Invalid end pointer",
+                  "mode: %d", mode,
+                  "bit_width: %u", bit_width,
+                  "precision: %d", precision);
+            success = 0;
+        }
+    }
+    if (success && (serialize_turns_to_deg(batch_buf, turns, 0, bit_width, ',') != batch_buf || *batch_buf != '\0')) {
+        ERROR("Not empty for no angle",
+              "bit_width: %u", bit_width,
+              "precision: %d", precision);
+        success = 0;
+    }
+    free(turns);
+    free(batch_buf);
+    return success;
+}
+
+
+/** Compare the batch functions with the functions for an angle for the numbers of the angles that aren't a multiple of the SIMD lanes. */
+int test_serialize_turns_to_deg_tails(void)
+{
+    unsigned int turns[20];
+    char batch_buf[TEST_BATCH_BUF_SIZE(20, TEST_MAX_BIT_WIDTH, 1)];
+    char expected[TEST_BATCH_BUF_SIZE(20, TEST_MAX_BIT_WIDTH, 1)];
+    unsigned int bit_width;
+    size_t num;
+    size_t i;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        for (i = 0; i < NUM_OF(turns); i++) {
+            /* The lanes stop at the different places. */
+            turns[i] = (unsigned int)((i * 2654435761ul) >> (32 - bit_width));
+        }
+        for (num = 1; num <= NUM_OF(turns); num++) {
+            char *p = expected;
+            for (i = 0; i < num; i++) {
+                if (i > 0) {
+                    *p++ = ';';
+                }
+                p = serialize_turn_to_deg_ps(p, turns[i], bit_width, 1);
+            }
+            if (serialize_turns_to_deg_ps(batch_buf, turns, num, bit_width, 1, ';') != batch_buf + (p - expected) || strcmp(batch_buf, expected) != 0) {
+                ERROR("Batch result mismatch",
+                      "bit_width: %u", bit_width,
+                      "number of turns: %u", (unsigned int)num,
+                      "expected: %s", expected,
+                      "observed: %s", batch_buf);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+
+/** Update the FNV-1a hash by a string and a terminator. */
+unsigned long long hash_string(unsigned long long hash, const char *s)
+{
+    for (; *s != '\0'; s++) {
+        hash ^= (unsigned char)*s;
+        hash *= 1099511628211ull;
+    }
+    hash ^= 0xFF;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+/** The hash of the serialized strings.
+    \param [in] mode 0: serialize_turn_to_deg(), 1: serialize_turn_to_deg_p(), 2: serialize_turn_to_deg_ps()
+    \param [in] min_bit_width The minimum bit-width.
+    \param [in] max_bit_width The maximum bit-width.
+    \param [in] max_precision The maximum precision.
+*/
+unsigned long long hash_serialized_strings(const int mode, const unsigned int min_bit_width, const unsigned int max_bit_width, const int max_precision)
+{
+    char buf[TEST_BUF_SIZE];
+    unsigned long long hash = 1469598103934665603ull;
+    unsigned int bit_width;
+    for (bit_width = min_bit_width; bit_width <= max_bit_width; bit_width++) {
+        int precision;
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; precision <= max_precision; precision++) {
+            unsigned long n;
+            for (n = 0; n < num_of_test_turns(bit_width); n++) {
+                const unsigned int turn = test_turn(n, bit_width);
+                switch (mode) {
+                case 0:
+                    serialize_turn_to_deg(buf, turn, bit_width);
+                    break;
+                case 1:
+                    serialize_turn_to_deg_p(buf, turn, bit_width, precision);
+                    break;
+                default:
+                    serialize_turn_to_deg_ps(buf, turn, bit_width, precision);
+                    break;
+                }
+                hash = hash_string(hash, buf);
+            }
+            if (mode == 0) {
+                /* precision is not used. */
+                break;
+            }
+        }
+    }
+    return hash;
+}
+
+/* The hashes of the strings that the reference engine (the division in conv_turn_to_deg_digit_array()) serializes. */
+const unsigned long long expected_hash[] = {
+    0xdc49aaa623f6c6fbull,
+    0x55f405682e80c631ull,
+    0xb51f692266739c0bull,
+};
+#ifdef SERDES_TURN_DEG_WIDE
+const unsigned long long expected_hash_wide[] = {
+    0x550d880d6fc762edull,
+    0xbfb0ca7070fb2920ull,
+    0xe12e772326917596ull,
+};
+#endif
+
+int test_serialized_strings_hash()
+{
+    int mode;
+    for (mode = 0; mode < 3; mode++) {
+        /* The range of all configurations. */
+        const unsigned long long hash = hash_serialized_strings(mode, SERDES_TURN_DEG_MIN_BIT_WIDTH, 22, 5);
+        if (hash != expected_hash[mode]) {
+            ERROR("The serialized strings are changed",
+                  "mode: %d", mode,
+                  "expected hash: %016llx", expected_hash[mode],
+                  "observed hash: %016llx", hash);
+            return 0;
+        }
+    }
+#ifdef SERDES_TURN_DEG_WIDE
+    for (mode = 0; mode < 3; mode++) {
+        const unsigned long long hash = hash_serialized_strings(mode, 23, TEST_MAX_BIT_WIDTH, TEST_MAX_PRECISION);
+        if (hash != expected_hash_wide[mode]) {
+            ERROR("The serialized strings are changed (wide)",
+                  "mode: %d", mode,
+                  "expected hash: %016llx", expected_hash_wide[mode],
+                  "observed hash: %016llx", hash);
+            return 0;
+        }
+    }
+#endif
+    return 1;
+}
+
+
 struct TestSerializeDegTable {
     unsigned int bit_width;
     unsigned int turn;
@@ -264,6 +619,12 @@ struct TestSerializeDegTable test_for_serialize_turn_to_deg[] = {
     { 4, 2, 1, "50" },
     { 4, 3, 1, "70" },
     { 4, 4, 1, "100" },
+#ifdef SERDES_TURN_DEG_WIDE
+    { 32, 1, 0, "0.0000001" },
+    { 32, 3, 0, "0.00000025" },
+    { 32, 2147483648u, 0, "180" },
+    { 32, 4294967295u, 0, "359.9999999" },
+#endif
 };
 
 struct TestSerializeDegTable test_for_serialize_turn_to_deg_p[] = {
@@ -277,6 +638,10 @@ struct TestSerializeDegTable test_for_serialize_turn_to_deg_p[] = {
     { 4, 0, -2, "0" },
     { 4, 1, -2, "20" },
     { 4, 2, -2, "50" },
+#ifdef SERDES_TURN_DEG_WIDE
+    { 32, 1, 8, "0.00000008" },
+    { 32, 2147483648u, 8, "180.00000000" },
+#endif
 };
 
 struct TestSerializeDegTable test_for_serialize_turn_to_deg_ps[] = {
@@ -290,12 +655,16 @@ struct TestSerializeDegTable test_for_serialize_turn_to_deg_ps[] = {
     { 4, 0, -2, "0" },
     { 4, 1, -2, "20" },
     { 4, 2, -2, "50" },
+#ifdef SERDES_TURN_DEG_WIDE
+    { 24, 1, 8, "0.00002146" },
+    { 32, 2147483648u, 8, "180" },
+#endif
 };
 
 int test_serialize_turn_to_deg(const struct TestSerializeDegTable *table, size_t n)
 {
     size_t i;
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
+    char buf[TEST_BUF_SIZE];
     for (i = 0; i < n; i++) {
         const char *end_ptr = serialize_turn_to_deg(buf, table[i].turn, table[i].bit_width);
         if (strcmp(buf, table[i].result) != 0) {
@@ -320,7 +689,7 @@ int test_serialize_turn_to_deg(const struct TestSerializeDegTable *table, size_t
 int test_serialize_turn_to_deg_p(const struct TestSerializeDegTable *table, size_t n)
 {
     size_t i;
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
+    char buf[TEST_BUF_SIZE];
     for (i = 0; i < n; i++) {
         const char *end_ptr = serialize_turn_to_deg_p(buf, table[i].turn, table[i].bit_width, table[i].precision);
         if (strcmp(buf, table[i].result) != 0) {
@@ -348,7 +717,7 @@ int test_serialize_turn_to_deg_p(const struct TestSerializeDegTable *table, size
 int test_serialize_turn_to_deg_ps(const struct TestSerializeDegTable *table, size_t n)
 {
     size_t i;
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
+    char buf[TEST_BUF_SIZE];
     for (i = 0; i < n; i++) {
         const char *end_ptr = serialize_turn_to_deg_ps(buf, table[i].turn, table[i].bit_width, table[i].precision);
         if (strcmp(buf, table[i].result) != 0) {
@@ -373,60 +742,48 @@ int test_serialize_turn_to_deg_ps(const struct TestSerializeDegTable *table, siz
 }
 
 
-struct TestDeserializeDegTable {
-    char *input;
+struct TestSerializeDegFixedTable {
     unsigned int bit_width;
     unsigned int turn;
-    int end_index;
+    int precision;
+    char pad;
+    char *expected;
 };
 
 
-struct TestDeserializeDegTable test_for_deserialize_turn_from_deg[] = {
-    { "89.99999", 1, 0, 8 },
-    { "90", 1, 1, 2 },
-    { "123", 1, 1, 3 },
-    { "269.99999", 1, 1, 9 },
-    { "270", 1, 0, 3 },
-    { "350", 1, 0, 3 },
-    { ".12345", 1, 0, 6 },
-    { "1.", 1, 0, 2 },
-    { "999.999", 1, 0, 7 },
-    { "0000.000", 1, 0, 3 },
-    { "1.234567890", 1, 0, 11 },
-    { "180.1.1", 1, 1, 5 },
-    { "+180.0", 2, 0, 0 },
-    { "-180.0", 2, 0, 0 },
-    { "    180.0", 2, 2, 9 },
-    { "180.0    ", 2, 2, 5 },
-    { "270.02b  ", 2, 3, 6 },
+struct TestSerializeDegFixedTable test_for_serialize_turn_to_deg_fixed[] = {
+    { 16, 0, 3, ' ', "  0.000" },
+    { 16, 0, 3, '0', "000.000" },
+    { 16, 16384, 3, ' ', " 90.000" },
+    { 16, 1, 3, ' ', "  0.005" },
+    { 16, 65535, 4, ' ', "359.9945" },
+    { 12, 1, 2, ' ', "  0.09" },
+    { 12, 4095, 2, '0', "359.91" },
+    { 8, 1, 1, ' ', "  1.4" },
+    { 4, 1, 0, ' ', " 23" },
+    { 4, 15, 0, '0', "338" },
+    { 1, 0, -2, ' ', "  0" },
+    { 1, 1, -2, ' ', "200" },
+    { 2, 1, -1, '0', "090" },
+#ifdef SERDES_TURN_DEG_WIDE
+    { 32, 1, 8, ' ', "  0.00000008" },
+    { 32, 4294967295u, 8, ' ', "359.99999992" },
+#endif
 };
 
-int test_deserialize_turn_from_deg(const struct TestDeserializeDegTable *table, size_t n)
+int test_serialize_turn_to_deg_fixed(const struct TestSerializeDegFixedTable *table, size_t n)
 {
     size_t i;
     for (i = 0; i < n; i++) {
-        const char *endptr;
-        int ptr_diff;
-        const unsigned int turn = deserialize_turn_from_deg(table[i].input, table[i].bit_width, &endptr);
-        ptr_diff = endptr - table[i].input;
-        if (turn != table[i].turn) {
-            ERROR("Observed turn is mismatched",
-                  "input text: %s", table[i].input,
-                  "bit_width: %u", table[i].bit_width,
-                  "expected turn: %u", table[i].turn,
-                  "observed turn: %u", turn,
-                  "expected end index: %d", table[i].end_index,
-                  "observed end index: %d", ptr_diff);
-            return 0;
-        }
-        if (ptr_diff != table[i].end_index) {
-            ERROR("Observed end index is mismatched",
-                  "input text: %s", table[i].input,
+        char buf[TEST_BUF_SIZE];
+        serialize_turn_to_deg_fixed(buf, table[i].turn, table[i].bit_width, table[i].precision, table[i].pad);
+        if (strcmp(buf, table[i].expected) != 0) {
+            ERROR("Result mismatch",
                   "bit_width: %u", table[i].bit_width,
-                  "expected turn: %u", table[i].turn,
-                  "observed turn: %u", turn,
-                  "expected end index: %d", table[i].end_index,
-                  "observed end index: %d", ptr_diff);
+                  "turn: %u", table[i].turn,
+                  "precision: %d", table[i].precision,
+                  "expected: \"%s\"", table[i].expected,
+                  "observed: \"%s\"", buf);
             return 0;
         }
     }
@@ -434,85 +791,1811 @@ int test_deserialize_turn_from_deg(const struct TestDeserializeDegTable *table,
 }
 
 
-int test_deg_is_just_integer()
+/** A precision below deg_fixed_min_precision() must be rejected without writing, because the buffer is sized by the given precision. */
+int test_serialize_turn_to_deg_fixed_rejected()
 {
-    char buf[SERDES_TURN_DEG_BUF_SIZE];
-    char buf2[4] = "0";
-    const unsigned int BIT_WIDTH = 9;
-    unsigned int i = 0;
-    unsigned int turn;
-    for (turn = 0; turn < (1u << BIT_WIDTH); turn++) {
-        serialize_turn_to_deg(buf, turn, BIT_WIDTH);
-        if (strcmp(buf, buf2) == 0) {
-            i++;
-            sprintf(buf2, "%u", i);
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        const int precision = deg_fixed_min_precision(bit_width) - 1;
+        const size_t size = SERDES_TURN_DEG_FIXED_WIDTH(precision) + 1;
+        char *buf;
+        size_t j;
+        if (precision < SERDES_TURN_DEG_MIN_PRECISION) {
+            continue;
         }
-    }
-    if (i != 360) {
-        ERROR("Too low resolution",
-              "bit_width: %u", BIT_WIDTH,
-              "last degree: %u (expected 360)", i);
-        return 0;
+        buf = malloc(size); /* exact size to catch overflow by ASan */
+        if (buf == NULL) {
+            ERROR("Out of memory",
+                  "size: %lu", (unsigned long)size);
+            return 0;
+        }
+        memset(buf, '#', size);
+        if (serialize_turn_to_deg_fixed(buf, (1u << (bit_width - 1)) - 1, bit_width, precision, ' ') != NULL) {
+            ERROR("Accepted precision below the minimum",
+                  "bit_width: %u", bit_width,
+                  "precision: %d", precision);
+            free(buf);
+            return 0;
+        }
+        for (j = 0; j < size; j++) {
+            if (buf[j] != '#') {
+                ERROR("Written to buf with rejected precision",
+                      "bit_width: %u", bit_width,
+                      "precision: %d", precision,
+                      "index: %lu", (unsigned long)j);
+                free(buf);
+                return 0;
+            }
+        }
+        free(buf);
     }
     return 1;
 }
 
+/** The number of the angles in each stream for test_serialize_turn_to_deg_incremental(). */
+#define TEST_NUM_OF_STREAM_TURNS 3000
 
-
-#define NUM_OF(a) (sizeof(a)/sizeof(a[0]))
-
-int main()
+/** Compare serialize_turn_to_deg_incremental() with serialize_turn_to_deg*() for a stream of the angles: sweeps up and down, small jitters, jumps, and wrap-arounds. */
+int test_serialize_turn_to_deg_incremental_stream(const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision)
 {
-    unsigned int bit_width;
-    int precision;
+    struct serdes_turn_deg_serializer serializer;
+    unsigned long seed = bit_width * 16 + (unsigned long)mode * 4 + (unsigned long)(precision - SERDES_TURN_DEG_MIN_PRECISION);
+    unsigned int turn;
+    int i;
 
-    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg()\n", stdout);
-    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH; bit_width++) {
-        if (!test_recoverable_serialize_turn_to_deg(bit_width)) {
-            return 1;
+    init_turn_to_deg_serializer(&serializer, bit_width, mode, precision);
+    seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+    turn = (unsigned int)seed;
+    for (i = 0; i < TEST_NUM_OF_STREAM_TURNS; i++) {
+        char expected[TEST_BUF_SIZE];
+        char observed[TEST_BUF_SIZE];
+        char *expected_end;
+        char *observed_end;
+        seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+        if (i < TEST_NUM_OF_STREAM_TURNS / 3) {
+            turn++; /* sweep up, which wraps around at the bit-width */
+        } else if (i < TEST_NUM_OF_STREAM_TURNS * 2 / 3) {
+            turn--; /* sweep down */
+        } else if (seed % 16 != 0) {
+            turn += (unsigned int)(seed >> 16) % 9 - 4; /* jitter */
+        } else {
+            turn = (unsigned int)(seed >> 4); /* jump */
+        }
+        switch (mode) {
+        case SERDES_TURN_DEG_MODE_SHORTEST:
+            expected_end = serialize_turn_to_deg(expected, turn, bit_width);
+            break;
+        case SERDES_TURN_DEG_MODE_P:
+            expected_end = serialize_turn_to_deg_p(expected, turn, bit_width, precision);
+            break;
+        default:
+            expected_end = serialize_turn_to_deg_ps(expected, turn, bit_width, precision);
+            break;
+        }
+        observed_end = serialize_turn_to_deg_incremental(&serializer, observed, turn);
+        if (strcmp(expected, observed) != 0 || expected_end - expected != observed_end - observed) {
+            ERROR("Result mismatch",
+                  "bit_width: %u", bit_width,
+                  "mode: %d", (int)mode,
+                  "precision: %d", precision,
+                  "turn: %u", turn,
+                  "expected: \"%s\"", expected,
+                  "observed: \"%s\"", observed);
+            return 0;
         }
     }
+    return 1;
+}
 
-    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg_p()\n", stdout);
-    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH; bit_width++) {
-        for (precision = SERDES_TURN_DEG_MIN_PRECISION; precision <= SERDES_TURN_DEG_MAX_PRECISION; precision++) {
-            if (!test_recoverable_serialize_turn_to_deg_p(bit_width, precision)) {
-                return 1;
+int test_serialize_turn_to_deg_incremental(void)
+{
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        int precision;
+        if (!test_serialize_turn_to_deg_incremental_stream(bit_width, SERDES_TURN_DEG_MODE_SHORTEST, 0)) {
+            return 0;
+        }
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; precision <= TEST_MAX_PRECISION; precision++) {
+            if (!test_serialize_turn_to_deg_incremental_stream(bit_width, SERDES_TURN_DEG_MODE_P, precision) ||
+                !test_serialize_turn_to_deg_incremental_stream(bit_width, SERDES_TURN_DEG_MODE_PS, precision)) {
+                return 0;
             }
         }
     }
+    return 1;
+}
 
-    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg_ps()\n", stdout);
-    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH; bit_width++) {
-        for (precision = SERDES_TURN_DEG_MIN_PRECISION; precision <= SERDES_TURN_DEG_MAX_PRECISION; precision++) {
-            if (!test_recoverable_serialize_turn_to_deg_ps(bit_width, precision)) {
-                return 1;
-            }
+
+/** The maximum number of the angles for test_serialize_turn_to_deg_length(). */
+#define TEST_NUM_OF_LENGTH_TURNS 2048
+
+/** Compare serialize_turn_to_deg_length() and serialize_turns_to_deg_length() with the lengths of the serialized strings. */
+int test_serialize_turn_to_deg_length_mode(const unsigned int *turns, const size_t num, const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision)
+{
+    size_t total;
+    size_t expected_total;
+    size_t i;
+    char *batch_buf;
+    char *end;
+    for (i = 0; i < num; i++) {
+        char buf[TEST_BUF_SIZE];
+        const size_t len = serialize_turn_to_deg_length(turns[i], bit_width, mode, precision);
+        switch (mode) {
+        case SERDES_TURN_DEG_MODE_SHORTEST:
+            end = serialize_turn_to_deg(buf, turns[i], bit_width);
+            break;
+        case SERDES_TURN_DEG_MODE_P:
+            end = serialize_turn_to_deg_p(buf, turns[i], bit_width, precision);
+            break;
+        default:
+            end = serialize_turn_to_deg_ps(buf, turns[i], bit_width, precision);
+            break;
+        }
+        if (len != (size_t)(end - buf)) {
+            ERROR("Length mismatch",
+                  "bit_width: %u", bit_width,
+                  "mode: %d", (int)mode,
+                  "precision: %d", precision,
+                  "serialized: \"%s\"", buf,
+                  "observed length: %u", (unsigned int)len);
+            return 0;
         }
     }
 
-    fputs("Testing: Certain Patterns: serialize_turn_to_deg()\n", stdout);
-    if (!test_serialize_turn_to_deg(test_for_serialize_turn_to_deg, NUM_OF(test_for_serialize_turn_to_deg))) {
-        return 1;
+    /* The batch serialize functions need only 1 byte for NUL after the strings, which the sanitizer checks. */
+    total = serialize_turns_to_deg_length(turns, num, bit_width, mode, precision);
+    batch_buf = malloc(total + 1);
+    if (batch_buf == NULL) {
+        ERROR("Out of memory",
+              "length: %u", (unsigned int)total);
+        return 0;
     }
-
-    fputs("Testing: Certain Patterns: serialize_turn_to_deg_p()\n", stdout);
-    if (!test_serialize_turn_to_deg_p(test_for_serialize_turn_to_deg_p, NUM_OF(test_for_serialize_turn_to_deg_p))) {
-        return 1;
+    switch (mode) {
+    case SERDES_TURN_DEG_MODE_SHORTEST:
+        end = serialize_turns_to_deg(batch_buf, turns, num, bit_width, ',');
+        break;
+    case SERDES_TURN_DEG_MODE_P:
+        end = serialize_turns_to_deg_p(batch_buf, turns, num, bit_width, precision, ',');
+        break;
+    default:
+        end = serialize_turns_to_deg_ps(batch_buf, turns, num, bit_width, precision, ',');
+        break;
     }
-
-    fputs("Testing: Certain Patterns: serialize_turn_to_deg_ps()\n", stdout);
-    if (!test_serialize_turn_to_deg_ps(test_for_serialize_turn_to_deg_ps, NUM_OF(test_for_serialize_turn_to_deg_ps))) {
-        return 1;
+    expected_total = (size_t)(end - batch_buf);
+    free(batch_buf);
+    if (total != expected_total) {
+        ERROR("Total length mismatch",
+              "bit_width: %u", bit_width,
+              "mode: %d", (int)mode,
+              "precision: %d", precision,
+              "expected length: %u", (unsigned int)expected_total,
+              "observed length: %u", (unsigned int)total);
+        return 0;
     }
+    return 1;
+}
 
-    fputs("Testing: Certain Patterns: deserialize_turn_from_deg()\n", stdout);
-    if (!test_deserialize_turn_from_deg(test_for_deserialize_turn_from_deg, NUM_OF(test_for_deserialize_turn_from_deg))) {
-        return 1;
+int test_serialize_turn_to_deg_length(void)
+{
+    unsigned int *turns = malloc(TEST_NUM_OF_LENGTH_TURNS * sizeof(unsigned int));
+    unsigned int bit_width;
+    int success = 1;
+    if (turns == NULL) {
+        ERROR("Out of memory",
+              "number of turns: %u", TEST_NUM_OF_LENGTH_TURNS);
+        return 0;
+    }
+    if (serialize_turns_to_deg_length(NULL, 0, 8, SERDES_TURN_DEG_MODE_SHORTEST, 0) != 0) {
+        ERROR("Total length of no angles is not 0",
+              "bit_width: %u", 8u);
+        success = 0;
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH && success; bit_width++) {
+        /* All angles, or the samples with a step that is not a power of 2 */
+        const size_t num = bit_width <= 11 ? 1u << bit_width : TEST_NUM_OF_LENGTH_TURNS;
+        const unsigned long step = bit_width <= 11 ? 1 : ((1ul << bit_width) - 1) / (TEST_NUM_OF_LENGTH_TURNS - 1);
+        int precision;
+        size_t i;
+        for (i = 0; i < num; i++) {
+            turns[i] = (unsigned int)(i * step);
+        }
+        success = test_serialize_turn_to_deg_length_mode(turns, num, bit_width, SERDES_TURN_DEG_MODE_SHORTEST, 0);
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; precision <= TEST_MAX_PRECISION && success; precision++) {
+            success = test_serialize_turn_to_deg_length_mode(turns, num, bit_width, SERDES_TURN_DEG_MODE_P, precision) &&
+                test_serialize_turn_to_deg_length_mode(turns, num, bit_width, SERDES_TURN_DEG_MODE_PS, precision);
+        }
     }
+    free(turns);
+    return success;
+}
 
-    fputs("Testing: Resolution\n", stdout);
-    if (!test_deg_is_just_integer()) {
+
+/** The number of the outputs of serialize_turn_to_deg_multi() to test: the shortest, and 2 modes for each precision. */
+#define TEST_NUM_OF_MULTI_OUTPUTS (1 + 2 * (TEST_MAX_PRECISION - SERDES_TURN_DEG_MIN_PRECISION + 1))
+
+int test_serialize_turn_to_deg_multi(void)
+{
+    char bufs[TEST_NUM_OF_MULTI_OUTPUTS][TEST_BUF_SIZE];
+    struct serdes_turn_deg_output outputs[TEST_NUM_OF_MULTI_OUTPUTS];
+    unsigned int bit_width;
+    size_t i;
+    /* The precisions in the descending and ascending order */
+    outputs[0].mode = SERDES_TURN_DEG_MODE_SHORTEST;
+    outputs[0].precision = 0;
+    for (i = 1; i < TEST_NUM_OF_MULTI_OUTPUTS; i++) {
+        const int n = (int)(i - 1) / 2;
+        outputs[i].mode = (i % 2) ? SERDES_TURN_DEG_MODE_P : SERDES_TURN_DEG_MODE_PS;
+        outputs[i].precision = (i % 2) ? TEST_MAX_PRECISION - n : SERDES_TURN_DEG_MIN_PRECISION + n;
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        /* All angles, or the samples with a step that is not a power of 2 */
+        const unsigned long num = bit_width <= 12 ? 1ul << bit_width : 4096;
+        const unsigned long step = bit_width <= 12 ? 1 : ((1ul << bit_width) - 1) / (num - 1);
+        unsigned long n;
+        for (n = 0; n < num; n++) {
+            const unsigned int turn = (unsigned int)(n * step);
+            for (i = 0; i < TEST_NUM_OF_MULTI_OUTPUTS; i++) {
+                outputs[i].buf = bufs[i];
+                outputs[i].end = NULL;
+            }
+            serialize_turn_to_deg_multi(turn, bit_width, outputs, TEST_NUM_OF_MULTI_OUTPUTS);
+            for (i = 0; i < TEST_NUM_OF_MULTI_OUTPUTS; i++) {
+                char expected[TEST_BUF_SIZE];
+                const char *expected_end;
+                switch (outputs[i].mode) {
+                case SERDES_TURN_DEG_MODE_SHORTEST:
+                    expected_end = serialize_turn_to_deg(expected, turn, bit_width);
+                    break;
+                case SERDES_TURN_DEG_MODE_P:
+                    expected_end = serialize_turn_to_deg_p(expected, turn, bit_width, outputs[i].precision);
+                    break;
+                default:
+                    expected_end = serialize_turn_to_deg_ps(expected, turn, bit_width, outputs[i].precision);
+                    break;
+                }
+                if (strcmp(outputs[i].buf, expected) != 0 || outputs[i].end - outputs[i].buf != expected_end - expected) {
+                    ERROR("Mismatch with the serialize function",
+                          "bit_width: %u", bit_width,
+                          "turn: %u", turn,
+                          "mode: %d", (int)outputs[i].mode,
+                          "precision: %d", outputs[i].precision,
+                          "expected: %s", expected,
+                          "observed: %s", outputs[i].buf);
+                    return 0;
+                }
+            }
+        }
+    }
+    /* No outputs */
+    serialize_turn_to_deg_multi(0, 8, outputs, 0);
+    return 1;
+}
+
+
+/** Convert a mantissa and a decimal exponent to the text to compare with the serialize functions. */
+void conv_decimal_to_text(char *text, const unsigned long mantissa, const int exponent)
+{
+    char digits[32];
+    const int len = snprintf(digits, sizeof(digits), "%0*lu", 1 - exponent, mantissa);
+    const int integer_len = len + exponent;
+    memcpy(text, digits, (size_t)integer_len);
+    text += integer_len;
+    if (exponent < 0) {
+        *text++ = '.';
+        memcpy(text, digits + integer_len, (size_t)-exponent);
+        text += -exponent;
+    }
+    *text = '\0';
+}
+
+int test_conv_turn_to_deg_decimal(void)
+{
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        /* All angles, or the samples with a step that is not a power of 2 */
+        const unsigned long num = bit_width <= 12 ? 1ul << bit_width : 4096;
+        const unsigned long step = bit_width <= 12 ? 1 : ((1ul << bit_width) - 1) / (num - 1);
+        unsigned long n;
+        for (n = 0; n < num; n++) {
+            const unsigned int turn = (unsigned int)(n * step);
+            int precision;
+            for (precision = SERDES_TURN_DEG_MIN_PRECISION - 1; precision <= TEST_MAX_PRECISION; precision++) {
+                /* precision below the range is the shortest. */
+                const int shortest = precision < SERDES_TURN_DEG_MIN_PRECISION;
+                int mode;
+                for (mode = shortest ? SERDES_TURN_DEG_MODE_SHORTEST : SERDES_TURN_DEG_MODE_P; mode <= (shortest ? SERDES_TURN_DEG_MODE_SHORTEST : SERDES_TURN_DEG_MODE_PS); mode++) {
+                    char expected[TEST_BUF_SIZE];
+                    char observed[TEST_BUF_SIZE * 2];
+                    int exponent = 1;
+                    const unsigned long mantissa = conv_turn_to_deg_decimal(turn, bit_width, (enum serdes_turn_deg_mode)mode, shortest ? 0 : precision, &exponent);
+                    if (mode == SERDES_TURN_DEG_MODE_SHORTEST) {
+                        serialize_turn_to_deg(expected, turn, bit_width);
+                    } else if (mode == SERDES_TURN_DEG_MODE_P) {
+                        serialize_turn_to_deg_p(expected, turn, bit_width, precision);
+                    } else {
+                        serialize_turn_to_deg_ps(expected, turn, bit_width, precision);
+                    }
+                    if (exponent < -TEST_MAX_PRECISION || exponent > 0) {
+                        observed[0] = '\0';
+                    } else {
+                        conv_decimal_to_text(observed, mantissa, exponent);
+                    }
+                    if (strcmp(observed, expected) != 0) {
+                        ERROR("Mismatch with the string",
+                              "bit_width: %u", bit_width,
+                              "turn: %u", turn,
+                              "mode and precision: %d", mode * 100 + precision,
+                              "mantissa: %lu", mantissa,
+                              "exponent: %d", exponent,
+                              "expected: %s", expected);
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/** The digit at the place k in a packed BCD, or 0 out of the digits. */
+int bcd_digit(const unsigned char *bcd, const int k)
+{
+    const int lowest_place = (bcd[0] >> 4) - SERDES_TURN_DEG_BCD_PLACE_BIAS;
+    const int highest_place = lowest_place + (bcd[0] & 0x0F) - 1;
+    const int index = highest_place - k;
+    return k > highest_place || k < lowest_place ? 0 : (bcd[1 + index / 2] >> (index % 2 ? 0 : 4)) & 0x0F;
+}
+
+/** Convert a packed BCD to the text to compare with serialize_turn_to_deg(). */
+void conv_bcd_to_text(char *text, const unsigned char *bcd)
+{
+    const int lowest_place = (bcd[0] >> 4) - SERDES_TURN_DEG_BCD_PLACE_BIAS;
+    int k = 2;
+    /* Zero suppress except the place 0 */
+    while (k > 0 && bcd_digit(bcd, k) == 0) {
+        k--;
+    }
+    for (; k >= lowest_place || k >= 0; k--) {
+        if (k == -1) {
+            *text++ = '.';
+        }
+        *text++ = '0' + bcd_digit(bcd, k);
+    }
+    *text = '\0';
+}
+
+int test_serialize_turn_to_deg_bcd(void)
+{
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        /* All angles, or the samples with a step that is not a power of 2 */
+        const unsigned long num = bit_width <= 12 ? 1ul << bit_width : 4096;
+        const unsigned long step = bit_width <= 12 ? 1 : ((1ul << bit_width) - 1) / (num - 1);
+        unsigned long n;
+        for (n = 0; n < num; n++) {
+            const unsigned int turn = (unsigned int)(n * step);
+            unsigned char bcd[SERDES_TURN_DEG_BCD_BUF_SIZE + 1];
+            char text[TEST_BUF_SIZE * 2];
+            char expected[TEST_BUF_SIZE];
+            unsigned int recovered = ~turn;
+            size_t consumed = 0;
+            size_t len;
+            int result;
+            memset(bcd, 0xFF, sizeof(bcd));
+            len = serialize_turn_to_deg_bcd(bcd, turn, bit_width);
+            serialize_turn_to_deg(expected, turn, bit_width);
+            conv_bcd_to_text(text, bcd);
+            if (len > SERDES_TURN_DEG_BCD_BUF_SIZE || bcd[len] != 0xFF || strcmp(text, expected) != 0 || len > strlen(expected) / 2 + 2) {
+                ERROR("Invalid packed BCD",
+                      "bit_width: %u", bit_width,
+                      "turn: %u", turn,
+                      "length: %u", (unsigned int)len,
+                      "expected: %s", expected,
+                      "observed: %s", text);
+                return 0;
+            }
+            result = deserialize_turn_from_deg_bcd(bcd, len, bit_width, &recovered, &consumed);
+            if (result != SERDES_TURN_DEG_SUCCESS || recovered != turn || consumed != len) {
+                ERROR("Packed BCD isn't recoverable",
+                      "bit_width: %u", bit_width,
+                      "turn: %u", turn,
+                      "result: %d", result,
+                      "recovered turn: %u", recovered,
+                      "consumed: %u", (unsigned int)consumed);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+struct TestDeserializeDegBcdTable {
+    unsigned char bcd[8];
+    size_t len;
+    char *text;
+    int result;
+};
+
+struct TestDeserializeDegBcdTable test_for_deserialize_turn_from_deg_bcd[] = {
+    { { 0xA1, 0x00 }, 2, "0", SERDES_TURN_DEG_SUCCESS },
+    { { 0x65, 0x12, 0x34, 0x50 }, 4, "123.45", SERDES_TURN_DEG_SUCCESS },
+    { { 0x65, 0x12, 0x34, 0x50, 0xFF }, 5, "123.45", SERDES_TURN_DEG_SUCCESS },
+    { { 0x92, 0x18 }, 2, "180", SERDES_TURN_DEG_SUCCESS },
+    { { 0x83, 0x72, 0x00 }, 3, "720", SERDES_TURN_DEG_SUCCESS },
+    { { 0x64, 0x45, 0x67 }, 3, "45.67", SERDES_TURN_DEG_SUCCESS },
+    { { 0x65, 0x90, 0x00, 0x50 }, 4, "900.05", SERDES_TURN_DEG_SUCCESS },
+    { { 0x0B, 0x35, 0x99, 0x99, 0x99, 0x99, 0x90 }, 7, "359.99999999", SERDES_TURN_DEG_SUCCESS },
+    { { 0x01, 0x10 }, 2, ".00000001", SERDES_TURN_DEG_SUCCESS },
+    { { 0 }, 0, "", SERDES_TURN_DEG_ERR_NO_DIGITS },
+    { { 0xA0 }, 1, "", SERDES_TURN_DEG_ERR_NO_DIGITS },
+    { { 0x65, 0x12, 0x34 }, 3, "", SERDES_TURN_DEG_ERR_NO_DIGITS },
+    { { 0xA2, 0x12 }, 2, "", SERDES_TURN_DEG_ERR_OUT_OF_RANGE },
+    { { 0xF1, 0x10 }, 2, "", SERDES_TURN_DEG_ERR_OUT_OF_RANGE },
+    { { 0x65, 0x1A, 0x34, 0x50 }, 4, "", SERDES_TURN_DEG_ERR_OUT_OF_RANGE },
+};
+
+int test_deserialize_turn_from_deg_bcd(const struct TestDeserializeDegBcdTable *table, size_t n)
+{
+    /* The digits after 5 places are ignored up to SERDES_TURN_DEG_MAX_BIT_WIDTH. */
+    const unsigned int bit_widths[] = { SERDES_TURN_DEG_MAX_BIT_WIDTH, TEST_MAX_BIT_WIDTH };
+    size_t i;
+    for (i = 0; i < n * NUM_OF(bit_widths); i++) {
+        const unsigned int bit_width = bit_widths[i / n];
+        unsigned int turn = 12345;
+        size_t consumed = 0;
+        const struct TestDeserializeDegBcdTable *const entry = &table[i % n];
+        const int result = deserialize_turn_from_deg_bcd(entry->bcd, entry->len, bit_width, &turn, &consumed);
+        const unsigned int expected = result == SERDES_TURN_DEG_SUCCESS ? deserialize_turn_from_deg(entry->text, bit_width, NULL) : 12345;
+        const size_t expected_consumed = result == SERDES_TURN_DEG_SUCCESS ? 1 + ((entry->bcd[0] & 0x0F) + 1) / 2 : 0;
+        if (result != entry->result || turn != expected || consumed != expected_consumed) {
+            ERROR("Mismatch with deserialize_turn_from_deg()",
+                  "bit_width: %u", bit_width,
+                  "text: %s", entry->text,
+                  "expected result: %d", entry->result,
+                  "observed result: %d", result,
+                  "expected turn: %u", expected,
+                  "observed turn: %u", turn);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+struct TestDeserializeDegTable {
+    char *input;
+    unsigned int bit_width;
+    unsigned int turn;
+    int end_index;
+};
+
+
+struct TestDeserializeDegTable test_for_deserialize_turn_from_deg[] = {
+    { "89.99999", 1, 0, 8 },
+    { "90", 1, 1, 2 },
+    { "123", 1, 1, 3 },
+    { "269.99999", 1, 1, 9 },
+    { "270", 1, 0, 3 },
+    { "350", 1, 0, 3 },
+    { ".12345", 1, 0, 6 },
+    { "1.", 1, 0, 2 },
+    { "999.999", 1, 0, 7 },
+    { "0000.000", 1, 0, 3 },
+    { "1.234567890", 1, 0, 11 },
+    { "180.1.1", 1, 1, 5 },
+    { "+180.0", 2, 0, 0 },
+    { "-180.0", 2, 0, 0 },
+    { "    180.0", 2, 2, 9 },
+    { "180.0    ", 2, 2, 5 },
+    { "270.02b  ", 2, 3, 6 },
+#ifdef SERDES_TURN_DEG_WIDE
+    { "359.9999999", 32, 4294967295u, 11 },
+    { "0.00000008", 32, 1, 10 },
+    { "359.99999998", 32, 0, 12 },
+    { "0.00002146", 23, 1, 10 }, /* 8 places are read more than 22 bits */
+#endif
+    { "0.00004292", 22, 0, 10 }, /* the digits after 5 places are ignored up to 22 bits in any build */
+};
+
+int test_deserialize_turn_from_deg(const struct TestDeserializeDegTable *table, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++) {
+        const char *endptr;
+        int ptr_diff;
+        const unsigned int turn = deserialize_turn_from_deg(table[i].input, table[i].bit_width, &endptr);
+        ptr_diff = endptr - table[i].input;
+        if (turn != table[i].turn) {
+            ERROR("Observed turn is mismatched",
+                  "input text: %s", table[i].input,
+                  "bit_width: %u", table[i].bit_width,
+                  "expected turn: %u", table[i].turn,
+                  "observed turn: %u", turn,
+                  "expected end index: %d", table[i].end_index,
+                  "observed end index: %d", ptr_diff);
+            return 0;
+        }
+        if (ptr_diff != table[i].end_index) {
+            ERROR("Observed end index is mismatched",
+                  "input text: %s", table[i].input,
+                  "bit_width: %u", table[i].bit_width,
+                  "expected turn: %u", table[i].turn,
+                  "observed turn: %u", turn,
+                  "expected end index: %d", table[i].end_index,
+                  "observed end index: %d", ptr_diff);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/** Copy a text to a buffer that isn't terminated by NUL, so that the sanitizer detects reading after the text. */
+char *copy_without_nul(const char *text, const size_t len)
+{
+    char *buf = malloc(len > 0 ? len : 1);
+    if (buf != NULL) {
+        memcpy(buf, text, len);
+    }
+    return buf;
+}
+
+int test_deserialize_turn_from_deg_n_same_as_nul(const struct TestDeserializeDegTable *table, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++) {
+        const size_t len = strlen(table[i].input);
+        char *text = copy_without_nul(table[i].input, len);
+        unsigned int turn = 0xDEADBEEFu;
+        size_t consumed;
+        int result;
+        if (text == NULL) {
+            ERROR("Out of memory",
+                  "input text: %s", table[i].input);
+            return 0;
+        }
+        result = deserialize_turn_from_deg_n(text, len, table[i].bit_width, &turn, &consumed);
+        free(text);
+        if (consumed != (size_t)table[i].end_index) {
+            ERROR("Consumed length is mismatched",
+                  "input text: %s", table[i].input,
+                  "bit_width: %u", table[i].bit_width,
+                  "expected consumed length: %d", table[i].end_index,
+                  "observed consumed length: %u", (unsigned int)consumed);
+            return 0;
+        }
+        if (result == SERDES_TURN_DEG_SUCCESS && turn != table[i].turn) {
+            ERROR("Observed turn is mismatched",
+                  "input text: %s", table[i].input,
+                  "bit_width: %u", table[i].bit_width,
+                  "expected turn: %u", table[i].turn,
+                  "observed turn: %u", turn);
+            return 0;
+        }
+        if (result != SERDES_TURN_DEG_SUCCESS && turn != 0xDEADBEEFu) {
+            ERROR("Turn is changed by an error",
+                  "input text: %s", table[i].input,
+                  "bit_width: %u", table[i].bit_width,
+                  "result: %d", result);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+struct TestDeserializeDegNTable {
+    char *input;
+    size_t len;
+    unsigned int bit_width;
+    int result;
+    unsigned int turn;
+    size_t consumed;
+};
+
+
+struct TestDeserializeDegNTable test_for_deserialize_turn_from_deg_n[] = {
+    { "180.25", 6, 16, SERDES_TURN_DEG_SUCCESS, 32814, 6 },
+    { "180.25", 4, 16, SERDES_TURN_DEG_SUCCESS, 32768, 4 },
+    { "180.25", 2, 16, SERDES_TURN_DEG_SUCCESS, 3277, 2 },
+    { "  90\n", 5, 2, SERDES_TURN_DEG_SUCCESS, 1, 4 },
+    { "90,180", 6, 2, SERDES_TURN_DEG_SUCCESS, 1, 2 },
+    { "270\0" "12", 6, 2, SERDES_TURN_DEG_SUCCESS, 3, 3 },
+    { ".5", 2, 8, SERDES_TURN_DEG_SUCCESS, 0, 2 },
+    { "1.", 2, 8, SERDES_TURN_DEG_SUCCESS, 1, 2 },
+    { "", 0, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 0 },
+    { "180", 0, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 0 },
+    { "   ", 3, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 3 },
+    { " .", 2, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 2 },
+    { ".x", 2, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 1 },
+    { "-1", 2, 8, SERDES_TURN_DEG_ERR_NO_DIGITS, 0, 0 },
+    { "1000", 4, 8, SERDES_TURN_DEG_ERR_OUT_OF_RANGE, 0, 3 },
+    { "1000", 3, 8, SERDES_TURN_DEG_SUCCESS, 71, 3 },
+};
+
+int test_deserialize_turn_from_deg_n(const struct TestDeserializeDegNTable *table, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++) {
+        char *text = copy_without_nul(table[i].input, table[i].len);
+        unsigned int turn = 0xDEADBEEFu;
+        size_t consumed;
+        int result;
+        if (text == NULL) {
+            ERROR("Out of memory",
+                  "input text: %s", table[i].input);
+            return 0;
+        }
+        result = deserialize_turn_from_deg_n(text, table[i].len, table[i].bit_width, &turn, &consumed);
+        free(text);
+        if (result != table[i].result || consumed != table[i].consumed ||
+            (result == SERDES_TURN_DEG_SUCCESS && turn != table[i].turn)) {
+            ERROR("Observed result is mismatched",
+                  "input text: %s", table[i].input,
+                  "length: %u", (unsigned int)table[i].len,
+                  "bit_width: %u", table[i].bit_width,
+                  "observed result: %d", result,
+                  "observed turn: %u", turn,
+                  "observed consumed length: %u", (unsigned int)consumed);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/** The number of the random texts for test_deserialize_turn_from_deg_random_texts(). */
+#define TEST_NUM_OF_RANDOM_TEXTS 100000
+/** The maximum length of a random text. */
+#define TEST_MAX_RANDOM_TEXT_LEN 24
+
+/** Compare deserialize_turn_from_deg() and deserialize_turn_from_deg_n() for random texts that have long runs of digits, so that both the 8-digit fast path and its tail are used. */
+int test_deserialize_turn_from_deg_random_texts(void)
+{
+    static const char alphabet[] = "0123456789012345678901234567890123456789.. \tx";
+    unsigned long seed = 1;
+    unsigned long n;
+    for (n = 0; n < TEST_NUM_OF_RANDOM_TEXTS; n++) {
+        char text[TEST_MAX_RANDOM_TEXT_LEN + 1];
+        char embedded[TEST_MAX_RANDOM_TEXT_LEN * 2];
+        char *exact;
+        const char *endptr;
+        unsigned int expected_turn;
+        unsigned int turn_exact = 0xDEADBEEFu;
+        unsigned int turn_embedded = 0xDEADBEEFu;
+        size_t consumed_exact;
+        size_t consumed_embedded;
+        int result_exact;
+        int result_embedded;
+        size_t len;
+        size_t i;
+        unsigned int bit_width;
+
+        /* LCG, which is enough to make the test reproducible */
+        seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+        len = (seed >> 16) % (TEST_MAX_RANDOM_TEXT_LEN + 1);
+        bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH + (unsigned int)(seed % (TEST_MAX_BIT_WIDTH - SERDES_TURN_DEG_MIN_BIT_WIDTH + 1));
+        for (i = 0; i < sizeof(embedded); i++) {
+            seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+            embedded[i] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+        }
+        memcpy(text, embedded, len);
+        text[len] = '\0';
+
+        expected_turn = deserialize_turn_from_deg(text, bit_width, &endptr);
+        exact = copy_without_nul(text, len);
+        if (exact == NULL) {
+            ERROR("Out of memory",
+                  "input text: %s", text);
+            return 0;
+        }
+        result_exact = deserialize_turn_from_deg_n(exact, len, bit_width, &turn_exact, &consumed_exact);
+        free(exact);
+        /* The characters after len are digits or others, which must not be read. */
+        result_embedded = deserialize_turn_from_deg_n(embedded, len, bit_width, &turn_embedded, &consumed_embedded);
+
+        if (consumed_exact != (size_t)(endptr - text) ||
+            (result_exact == SERDES_TURN_DEG_SUCCESS && turn_exact != expected_turn)) {
+            ERROR("Result is mismatched with the text terminated by NUL",
+                  "input text: %s", text,
+                  "bit_width: %u", bit_width,
+                  "expected turn: %u", expected_turn,
+                  "observed turn: %u", turn_exact,
+                  "expected consumed length: %u", (unsigned int)(endptr - text),
+                  "observed consumed length: %u", (unsigned int)consumed_exact);
+            return 0;
+        }
+        if (result_embedded != result_exact || turn_embedded != turn_exact || consumed_embedded != consumed_exact) {
+            ERROR("Result is mismatched with the text followed by other characters",
+                  "input text: %s", text,
+                  "bit_width: %u", bit_width,
+                  "expected result: %d", result_exact,
+                  "observed result: %d", result_embedded,
+                  "expected turn: %u", turn_exact,
+                  "observed turn: %u", turn_embedded);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+int test_deserialize_turns_from_deg(const struct TestDeserializeDegTable *table, size_t n, const char separator)
+{
+    const char *const extra_input[] = {
+        "",
+        "12.345678901234567890123456789",
+        "000000000000000000000000000000001",
+        "1.2345678901234567890123456789012345678901234567890",
+        "359.99999999999999999999999999999999999999999999999",
+    };
+    const size_t num = n + NUM_OF(extra_input);
+    char text[1024];
+    char field[256];
+    unsigned int turns[64];
+    const char *endptrs[64];
+    const char *next;
+    size_t len = 0;
+    size_t i;
+    size_t parsed;
+    for (i = 0; i < num; i++) {
+        const char *input = i < n ? table[i].input : extra_input[i - n];
+        if (i > 0) {
+            text[len++] = separator;
+        }
+        strcpy(text + len, input);
+        len += strlen(input);
+    }
+    /* The last separator doesn't make an empty field. */
+    text[len] = separator;
+    text[len + 1] = '#';
+
+    parsed = deserialize_turns_from_deg(text, len + 1, separator, 2, turns, NUM_OF(turns), endptrs, &next);
+    if (parsed != num || next != text + len + 1) {
+        ERROR("Invalid number of fields",
+              "separator: %d", separator,
+              "expected: %u", (unsigned int)num,
+              "observed: %u", (unsigned int)parsed);
+        return 0;
+    }
+    for (i = 0; i < num; i++) {
+        const char *input = i < n ? table[i].input : extra_input[i - n];
+        const char *field_begin = (i == 0 ? text : strchr(endptrs[i - 1], separator) + 1);
+        const char *endptr;
+        unsigned int expected;
+        strcpy(field, input);
+        expected = deserialize_turn_from_deg(field, 2, &endptr);
+        if (turns[i] != expected || endptrs[i] - field_begin != endptr - field) {
+            ERROR("Mismatch with deserialize_turn_from_deg()",
+                  "separator: %d", separator,
+                  "input text: %s", input,
+                  "expected turn: %u", expected,
+                  "observed turn: %u", turns[i],
+                  "expected end index: %d", (int)(endptr - field),
+                  "observed end index: %d", (int)(endptrs[i] - field_begin));
+            return 0;
+        }
+    }
+
+    /* Stop at max_num. */
+    parsed = deserialize_turns_from_deg(text, len, separator, 2, turns, 2, NULL, &next);
+    if (parsed != 2 || next != strchr(strchr(text, separator) + 1, separator) + 1) {
+        ERROR("Invalid next pointer",
+              "separator: %d", separator,
+              "parsed: %u", (unsigned int)parsed);
+        return 0;
+    }
+    return 1;
+}
+
+
+int test_recoverable_deserialize_turns_from_deg(const unsigned int bit_width)
+{
+    const size_t num = 1u << bit_width;
+    unsigned int *turns = malloc(num * sizeof(turns[0]));
+    unsigned int *recovered = malloc(num * sizeof(recovered[0]));
+    char *text = malloc(TEST_BATCH_BUF_SIZE(num, bit_width, 3));
+    int success = 1;
+    size_t i;
+    if (turns == NULL || recovered == NULL || text == NULL) {
+        ERROR("Out of memory",
+              "bit_width: %u", bit_width);
+        success = 0;
+    } else {
+        const char *end;
+        size_t parsed;
+        for (i = 0; i < num; i++) {
+            turns[i] = (unsigned int)i;
+        }
+        end = serialize_turns_to_deg_ps(text, turns, num, bit_width, 3, '\n');
+        parsed = deserialize_turns_from_deg(text, end - text, '\n', bit_width, recovered, num, NULL, NULL);
+        if (parsed != num) {
+            ERROR("Invalid number of fields",
+                  "bit_width: %u", bit_width,
+                  "parsed: %u", (unsigned int)parsed);
+            success = 0;
+        }
+        for (i = 0; success && i < num; i++) {
+            if (turns[i] != recovered[i]) {
+                ERROR("Deserialized turn mismatch",
+                      "bit_width: %u", bit_width,
+                      "turn: %u", turns[i],
+                      "recovered turn: %u", recovered[i]);
+                success = 0;
+            }
+        }
+    }
+    free(turns);
+    free(recovered);
+    free(text);
+    return success;
+}
+
+
+/** The number of the angles to test the parallel batch functions, which is enough to split into many tasks. */
+#define TEST_NUM_OF_PARALLEL_TURNS (1u << 17)
+
+/** The context of test_executor(). */
+struct TestExecutorContext {
+    size_t num_of_calls;
+    size_t num_of_tasks;
+};
+
+/** The arguments of a thread of test_executor(). */
+struct TestExecutorThread {
+    serdes_turn_deg_task task;
+    void *task_arg;
+    size_t index;
+};
+
+void *run_test_executor_thread(void *arg)
+{
+    const struct TestExecutorThread *const thread = arg;
+    thread->task(thread->task_arg, thread->index);
+    return NULL;
+}
+
+/** An executor that runs each task on its own thread in the reverse order. */
+void test_executor(void *context, size_t num_of_tasks, serdes_turn_deg_task task, void *task_arg)
+{
+    struct TestExecutorContext *const executor_context = context;
+    pthread_t threads[SERDES_TURN_DEG_MAX_TASKS];
+    struct TestExecutorThread args[SERDES_TURN_DEG_MAX_TASKS];
+    int started[SERDES_TURN_DEG_MAX_TASKS];
+    size_t i;
+    executor_context->num_of_calls++;
+    executor_context->num_of_tasks += num_of_tasks;
+    for (i = num_of_tasks; i-- > 0;) {
+        args[i].task = task;
+        args[i].task_arg = task_arg;
+        args[i].index = i;
+        started[i] = pthread_create(&threads[i], NULL, run_test_executor_thread, &args[i]) == 0;
+        if (!started[i]) {
+            task(task_arg, i);
+        }
+    }
+    for (i = 0; i < num_of_tasks; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+int test_serialize_turns_to_deg_parallel_mode(const unsigned int *turns, const size_t num, const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision, char *expected, char *observed)
+{
+    const size_t tasks[] = { 1, 3, 8, SERDES_TURN_DEG_MAX_TASKS };
+    const char *expected_end;
+    size_t i;
+    switch (mode) {
+    case SERDES_TURN_DEG_MODE_SHORTEST:
+        expected_end = serialize_turns_to_deg(expected, turns, num, bit_width, ',');
+        break;
+    case SERDES_TURN_DEG_MODE_P:
+        expected_end = serialize_turns_to_deg_p(expected, turns, num, bit_width, precision, ',');
+        break;
+    default:
+        expected_end = serialize_turns_to_deg_ps(expected, turns, num, bit_width, precision, ',');
+        break;
+    }
+    for (i = 0; i < NUM_OF(tasks) * 2; i++) {
+        struct TestExecutorContext context = { 0, 0 };
+        const int use_executor = i % 2;
+        const char *const observed_end = serialize_turns_to_deg_parallel(observed, turns, num, bit_width, mode, precision, ',', tasks[i / 2], use_executor ? test_executor : NULL, &context);
+        if (observed_end - observed != expected_end - expected || strcmp(observed, expected) != 0) {
+            ERROR("Mismatch with the batch serialize function",
+                  "bit_width: %u", bit_width,
+                  "mode: %d", (int)mode,
+                  "precision: %d", precision,
+                  "number of turns: %u", (unsigned int)num,
+                  "number of tasks: %u", (unsigned int)tasks[i / 2],
+                  "executor: %d", use_executor);
+            return 0;
+        }
+        if (use_executor && tasks[i / 2] > 1 && num >= 2 * 4096 && (context.num_of_calls != 1 || context.num_of_tasks <= 1)) {
+            ERROR("The executor isn't used",
+                  "number of turns: %u", (unsigned int)num,
+                  "number of tasks: %u", (unsigned int)tasks[i / 2],
+                  "number of calls: %u", (unsigned int)context.num_of_calls);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/** Test serialize_turns_to_deg_parallel() with a precision in the buffers of the length that the document requires. */
+int test_serialize_turns_to_deg_parallel_precision(const unsigned int *turns, const unsigned int bit_width, const int precision)
+{
+    const size_t nums[] = { 0, 1, 4097, TEST_NUM_OF_PARALLEL_TURNS };
+    char *expected = malloc(TEST_BATCH_BUF_SIZE(TEST_NUM_OF_PARALLEL_TURNS, bit_width, precision));
+    char *observed = malloc(TEST_BATCH_BUF_SIZE(TEST_NUM_OF_PARALLEL_TURNS, bit_width, precision));
+    int success = 1;
+    size_t i;
+    if (expected == NULL || observed == NULL) {
+        ERROR("Out of memory",
+              "number of turns: %u", TEST_NUM_OF_PARALLEL_TURNS);
+        success = 0;
+    }
+    for (i = 0; success && i < NUM_OF(nums); i++) {
+        success = (precision > SERDES_TURN_DEG_MAX_PRECISION || test_serialize_turns_to_deg_parallel_mode(turns, nums[i], bit_width, SERDES_TURN_DEG_MODE_SHORTEST, 0, expected, observed)) &&
+            test_serialize_turns_to_deg_parallel_mode(turns, nums[i], bit_width, SERDES_TURN_DEG_MODE_P, precision, expected, observed) &&
+            test_serialize_turns_to_deg_parallel_mode(turns, nums[i], bit_width, SERDES_TURN_DEG_MODE_PS, precision, expected, observed);
+    }
+    free(expected);
+    free(observed);
+    return success;
+}
+
+int test_serialize_turns_to_deg_parallel(void)
+{
+    const unsigned int bit_widths[] = { 8, 16, SERDES_TURN_DEG_MAX_BIT_WIDTH, TEST_MAX_BIT_WIDTH };
+    unsigned int *turns = malloc(TEST_NUM_OF_PARALLEL_TURNS * sizeof(turns[0]));
+    int success = 1;
+    size_t i;
+    size_t j;
+    if (turns == NULL) {
+        ERROR("Out of memory",
+              "number of turns: %u", TEST_NUM_OF_PARALLEL_TURNS);
+        success = 0;
+    }
+    for (i = 0; success && i < NUM_OF(bit_widths); i++) {
+        const unsigned int bit_width = bit_widths[i];
+        for (j = 0; j < TEST_NUM_OF_PARALLEL_TURNS; j++) {
+            turns[j] = (unsigned int)((j * 2654435761ul) & ((2ul << (bit_width - 1)) - 1));
+        }
+        success = test_serialize_turns_to_deg_parallel_precision(turns, bit_width, 3) &&
+            (TEST_MAX_PRECISION == SERDES_TURN_DEG_MAX_PRECISION || test_serialize_turns_to_deg_parallel_precision(turns, bit_width, TEST_MAX_PRECISION));
+    }
+    free(turns);
+    return success;
+}
+
+int test_deserialize_turns_from_deg_parallel(void)
+{
+    const size_t tasks[] = { 1, 3, 8, SERDES_TURN_DEG_MAX_TASKS };
+    const size_t max_nums[] = { 0, 1, TEST_NUM_OF_PARALLEL_TURNS / 3, TEST_NUM_OF_PARALLEL_TURNS * 2 };
+    const size_t max_num = TEST_NUM_OF_PARALLEL_TURNS * 2;
+    char *text = malloc(TEST_BATCH_BUF_SIZE(TEST_NUM_OF_PARALLEL_TURNS, 22, 2) * 2);
+    unsigned int *expected_turns = malloc(max_num * sizeof(unsigned int));
+    unsigned int *observed_turns = malloc(max_num * sizeof(unsigned int));
+    const char **expected_endptrs = malloc(max_num * sizeof(const char *));
+    const char **observed_endptrs = malloc(max_num * sizeof(const char *));
+    size_t len = 0;
+    int success = 1;
+    size_t i;
+    size_t j;
+    if (text == NULL || expected_turns == NULL || observed_turns == NULL || expected_endptrs == NULL || observed_endptrs == NULL) {
+        ERROR("Out of memory",
+              "number of turns: %u", TEST_NUM_OF_PARALLEL_TURNS);
+        success = 0;
+    } else {
+        /* Some empty fields, some invalid fields, and the separator at the end */
+        for (i = 0; i < TEST_NUM_OF_PARALLEL_TURNS; i++) {
+            len = serialize_turn_to_deg_ps(text + len, (unsigned int)((i * 2654435761ul) & 0x3FFFFFu), 22, 2) - text;
+            if (i % 1000 == 0) {
+                text[len++] = '\n';
+            } else if (i % 1001 == 0) {
+                text[len++] = 'x';
+            }
+            text[len++] = '\n';
+        }
+    }
+    for (i = 0; success && i < NUM_OF(max_nums); i++) {
+        const char *expected_next;
+        const size_t expected_num = deserialize_turns_from_deg(text, len, '\n', 22, expected_turns, max_nums[i], expected_endptrs, &expected_next);
+        for (j = 0; success && j < NUM_OF(tasks) * 2; j++) {
+            struct TestExecutorContext context = { 0, 0 };
+            const int use_executor = j % 2;
+            const char *observed_next;
+            const size_t observed_num = deserialize_turns_from_deg_parallel(text, len, '\n', 22, observed_turns, max_nums[i], observed_endptrs, &observed_next, tasks[j / 2], use_executor ? test_executor : NULL, &context);
+            if (observed_num != expected_num || observed_next != expected_next ||
+                memcmp(observed_turns, expected_turns, expected_num * sizeof(unsigned int)) != 0 ||
+                memcmp(observed_endptrs, expected_endptrs, expected_num * sizeof(const char *)) != 0) {
+                ERROR("Mismatch with deserialize_turns_from_deg()",
+                      "max_num: %u", (unsigned int)max_nums[i],
+                      "number of tasks: %u", (unsigned int)tasks[j / 2],
+                      "executor: %d", use_executor,
+                      "expected number: %u", (unsigned int)expected_num,
+                      "observed number: %u", (unsigned int)observed_num,
+                      "next offset: %d", (int)(observed_next - text));
+                success = 0;
+            }
+        }
+    }
+    if (success && deserialize_turns_from_deg_parallel(text, len, '\n', 22, observed_turns, max_num, NULL, NULL, 8, test_executor, &(struct TestExecutorContext){ 0, 0 }) != TEST_NUM_OF_PARALLEL_TURNS + TEST_NUM_OF_PARALLEL_TURNS / 1000 + 1) {
+        ERROR("Invalid number of fields without endptrs",
+              "number of turns: %u", TEST_NUM_OF_PARALLEL_TURNS);
+        success = 0;
+    }
+    free(text);
+    free(expected_turns);
+    free(observed_turns);
+    free(expected_endptrs);
+    free(observed_endptrs);
+    return success;
+}
+
+
+/** The length of the random text for test_deserialize_turns_from_deg_chunk(). */
+#define TEST_STREAM_TEXT_LEN 4096
+/** The maximum number of the fields in the random text. */
+#define TEST_STREAM_MAX_FIELDS (TEST_STREAM_TEXT_LEN + 1)
+
+/** The fields that a streaming parser calls back. */
+struct TestParserContext {
+    size_t num; /**< The number of the fields. */
+    unsigned int turns[TEST_STREAM_MAX_FIELDS]; /**< The turns of the fields. */
+    int results[TEST_STREAM_MAX_FIELDS]; /**< The results of the fields. */
+};
+
+/** A callback of a streaming parser to record the fields. */
+void test_parser_callback(void *context, unsigned int turn, int result)
+{
+    struct TestParserContext *const parser_context = (struct TestParserContext *)context;
+    if (parser_context->num < TEST_STREAM_MAX_FIELDS) {
+        parser_context->turns[parser_context->num] = turn;
+        parser_context->results[parser_context->num] = result;
+    }
+    parser_context->num++;
+}
+
+/** Compare a streaming parser and deserialize_turns_from_deg() for a random text split into the chunks of various lengths. */
+int test_deserialize_turns_from_deg_chunk(void)
+{
+    static const char alphabet[] = "0123456789012345678901234567890123456789.. \tx,,,,";
+    const size_t chunk_lens[] = { 1, 2, 3, 7, 8, 9, 64, 1000, TEST_STREAM_TEXT_LEN };
+    static char text[TEST_STREAM_TEXT_LEN];
+    static unsigned int expected_turns[TEST_STREAM_MAX_FIELDS];
+    static int expected_results[TEST_STREAM_MAX_FIELDS];
+    static const char *endptrs[TEST_STREAM_MAX_FIELDS];
+    static struct TestParserContext context;
+    unsigned long seed = 1;
+    unsigned int bit_width;
+    size_t i;
+    size_t j;
+    for (i = 0; i < sizeof(text); i++) {
+        /* LCG, which is enough to make the test reproducible */
+        seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+        text[i] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width += 7) {
+        /* The text with and without the separator at the end */
+        size_t len;
+        for (len = TEST_STREAM_TEXT_LEN - 1; len <= TEST_STREAM_TEXT_LEN; len++) {
+            const size_t expected_num = deserialize_turns_from_deg(text, len, ',', bit_width, expected_turns, TEST_STREAM_MAX_FIELDS, endptrs, NULL);
+            for (i = 0; i < expected_num; i++) {
+                const char *const field_begin = i == 0 ? text : (const char *)memchr(endptrs[i - 1], ',', (size_t)(text + len - endptrs[i - 1])) + 1;
+                const char *const field_end = memchr(field_begin, ',', (size_t)(text + len - field_begin));
+                const size_t field_len = (field_end != NULL ? field_end : text + len) - field_begin;
+                unsigned int turn;
+                size_t consumed;
+                expected_results[i] = deserialize_turn_from_deg_n(field_begin, field_len, bit_width, &turn, &consumed);
+                if (expected_results[i] == SERDES_TURN_DEG_SUCCESS && consumed != field_len) {
+                    expected_results[i] = SERDES_TURN_DEG_ERR_INVALID_CHAR;
+                }
+            }
+            for (i = 0; i < NUM_OF(chunk_lens); i++) {
+                struct serdes_turn_deg_parser parser;
+                size_t num = 0;
+                context.num = 0;
+                init_turns_from_deg_parser(&parser, ',', bit_width, test_parser_callback, &context);
+                for (j = 0; j < len; j += chunk_lens[i]) {
+                    const size_t chunk_len = len - j < chunk_lens[i] ? len - j : chunk_lens[i];
+                    num += deserialize_turns_from_deg_chunk(&parser, text + j, chunk_len);
+                    /* An empty chunk changes nothing. */
+                    num += deserialize_turns_from_deg_chunk(&parser, text + j, 0);
+                }
+                num += finish_turns_from_deg_parser(&parser);
+                if (num != expected_num || context.num != expected_num ||
+                    memcmp(context.turns, expected_turns, expected_num * sizeof(unsigned int)) != 0 ||
+                    memcmp(context.results, expected_results, expected_num * sizeof(int)) != 0) {
+                    ERROR("Mismatch with deserialize_turns_from_deg()",
+                          "bit_width: %u", bit_width,
+                          "length: %u", (unsigned int)len,
+                          "chunk length: %u", (unsigned int)chunk_lens[i],
+                          "expected number: %u", (unsigned int)expected_num,
+                          "observed number: %u", (unsigned int)num,
+                          "callbacks: %u", (unsigned int)context.num);
+                    return 0;
+                }
+                /* The parser is reset for the next stream. */
+                if (finish_turns_from_deg_parser(&parser) != 0 || deserialize_turns_from_deg_chunk(&parser, "1,", 2) != 1 || context.turns[context.num - 1] != deserialize_turn_from_deg("1", bit_width, NULL)) {
+                    ERROR("Parser isn't reset",
+                          "bit_width: %u", bit_width,
+                          "chunk length: %u", (unsigned int)chunk_lens[i]);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+
+/** The number of the turns to test the thresholds of the rounding in a bit-width. */
+#define TEST_NUM_OF_THRESHOLD_TURNS 1024u
+
+/** The reference of the conversion from a degree multiplied by 10**decimals to a turn, which divides bit by bit as the library used to do. */
+unsigned int reference_scaled_deg_to_turn(const unsigned long long deg, const int decimals, const unsigned int bit_width)
+{
+    unsigned long long S = 180;
+    unsigned long long R = deg;
+    unsigned long long turn = 0;
+    unsigned int i;
+    for (i = 0; i < (unsigned int)decimals; i++) {
+        S *= 10;
+    }
+    for (i = 0; i <= bit_width; i++) {
+        const unsigned long long U = R / S;
+        R -= U * S;
+        R <<= 1;
+        turn = (turn << 1) | U;
+    }
+    turn = turn / 2 + (turn & 1);
+    return (unsigned int)(turn & ((1ull << bit_width) - 1));
+}
+
+/** Check the conversion around the degrees where the rounded turn changes, in all bit-widths and precisions. */
+int test_deserialize_turn_from_deg_thresholds(void)
+{
+    unsigned int bit_width;
+    int precision;
+    for (precision = 0; precision <= TEST_MAX_PRECISION; precision++) {
+        unsigned long long scale = 1;
+        int i;
+        for (i = 0; i < precision; i++) {
+            scale *= 10;
+        }
+        for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+            const unsigned long num = bit_width <= 10 ? 1ul << bit_width : TEST_NUM_OF_THRESHOLD_TURNS;
+            const unsigned long step = (1ul << bit_width) / num;
+            /* The digits after 5 places are ignored up to SERDES_TURN_DEG_MAX_BIT_WIDTH. */
+            const int decimals = bit_width <= SERDES_TURN_DEG_MAX_BIT_WIDTH && precision > SERDES_TURN_DEG_MAX_PRECISION ? SERDES_TURN_DEG_MAX_PRECISION : precision;
+            unsigned long long truncation = 1;
+            unsigned long n;
+            for (i = decimals; i < precision; i++) {
+                truncation *= 10;
+            }
+            for (n = 0; n < num; n++) {
+                /* The turn is rounded up at deg = (2 * turn + 1) * 180 * scale / 2**bit_width. */
+                const unsigned long turn = n * step + (n * 2654435761ul) % step;
+                const long double threshold = (2.0L * turn + 1) * 180.0L * scale / ldexpl(1.0L, (int)bit_width);
+                const unsigned long long base = (unsigned long long)floorl(threshold);
+                unsigned long long deg;
+                for (deg = base >= 2 ? base - 2 : 0; deg <= base + 2 && deg < 360 * scale; deg++) {
+                    const unsigned int expected = reference_scaled_deg_to_turn(deg / truncation, decimals, bit_width);
+                    char text[3 + 1 + 20 + 1]; /* The worst case of the format for the compiler, which doesn't know the range of precision. */
+                    unsigned int fixed_turn;
+                    unsigned int text_turn;
+                    if (precision > 0) {
+                        snprintf(text, sizeof(text), "%03u.%0*lu", (unsigned int)(deg / scale) % 1000, precision, (unsigned long)(deg % scale));
+                    } else {
+                        snprintf(text, sizeof(text), "%03u", (unsigned int)deg);
+                    }
+                    fixed_turn = deserialize_turn_from_deg_fixed(text, bit_width, precision);
+                    text_turn = deserialize_turn_from_deg(text, bit_width, NULL);
+                    if (fixed_turn != expected || text_turn != expected) {
+                        ERROR("Mismatch with the bit-serial division",
+                              "bit_width: %u", bit_width,
+                              "text: %s", text,
+                              "expected turn: %u", expected,
+                              "fixed turn: %u", fixed_turn,
+                              "turn: %u", text_turn);
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+
+int test_deg_is_just_integer()
+{
+    char buf[TEST_BUF_SIZE];
+    char buf2[4] = "0";
+    const unsigned int BIT_WIDTH = 9;
+    unsigned int i = 0;
+    unsigned int turn;
+    for (turn = 0; turn < (1u << BIT_WIDTH); turn++) {
+        serialize_turn_to_deg(buf, turn, BIT_WIDTH);
+        if (strcmp(buf, buf2) == 0) {
+            i++;
+            sprintf(buf2, "%u", i);
+        }
+    }
+    if (i != 360) {
+        ERROR("Too low resolution",
+              "bit_width: %u", BIT_WIDTH,
+              "last degree: %u (expected 360)", i);
+        return 0;
+    }
+    return 1;
+}
+
+
+struct TestConvDegTable {
+    double deg;
+    unsigned int bit_width;
+    unsigned int turn;
+};
+
+struct TestConvDegTable test_for_conv_deg_to_turn[] = {
+    { -90.0, 2, 3 },
+    { -1.0, 8, 255 },
+    { -0.5, 8, 0 }, /* 359.5 is rounded up to 360 */
+    { -450.0, 4, 12 },
+    { -1e-300, 8, 0 }, /* 360 by the rounding of the addition */
+    { 359.5, 8, 0 },
+    { -90.0, 22, 3145728 },
+#ifdef SERDES_TURN_DEG_WIDE
+    { -90.0, 32, 3221225472u },
+    { -1e-300, 32, 0 },
+#endif
+};
+
+/** Check conv_deg_to_turn() for negative and out of range degrees, which are reduced to [0, 360) in the same way for any bit-width. */
+int test_conv_deg_to_turn(const struct TestConvDegTable *table, size_t n)
+{
+    const double degs[] = { 0.5, 1.0, 90.0, 179.75, 359.0 };
+    unsigned int bit_width;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        const unsigned int turn = conv_deg_to_turn(table[i].deg, table[i].bit_width);
+        if (turn != table[i].turn) {
+            ERROR("Observed turn is mismatched",
+                  "degree: %g", table[i].deg,
+                  "bit_width: %u", table[i].bit_width,
+                  "expected turn: %u", table[i].turn,
+                  "observed turn: %u", turn);
+            return 0;
+        }
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        for (i = 0; i < NUM_OF(degs); i++) {
+            /* 360 - deg and deg + 720 are exact. */
+            const unsigned int expected = conv_deg_to_turn(360.0 - degs[i], bit_width);
+            const unsigned int negative = conv_deg_to_turn(-degs[i], bit_width);
+            const unsigned int wrapped = conv_deg_to_turn(degs[i] + 720.0, bit_width);
+            if (negative != expected || wrapped != conv_deg_to_turn(degs[i], bit_width) || (unsigned long)expected >= 1ul << bit_width) {
+                ERROR("The reduction depends on the sign or the range",
+                      "degree: %g", degs[i],
+                      "bit_width: %u", bit_width,
+                      "expected turn: %u", expected,
+                      "negative turn: %u", negative,
+                      "wrapped turn: %u", wrapped);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/** The number of the degrees for test_conv_degs_to_turns(), which isn't a multiple of the SIMD width so that the tail is tested. */
+#define TEST_NUM_OF_DEGS 4099
+
+/** Compare conv_degs_to_turns() with conv_deg_to_turn() for degrees around the multiples of 360, negative, and large degrees. */
+int test_conv_degs_to_turns(void)
+{
+    double *degs = malloc(TEST_NUM_OF_DEGS * sizeof(double));
+    unsigned int *turns = malloc(TEST_NUM_OF_DEGS * sizeof(unsigned int));
+    unsigned long seed = 1;
+    unsigned int bit_width;
+    size_t i;
+    int success = 1;
+    if (degs == NULL || turns == NULL) {
+        ERROR("Out of memory",
+              "number of degrees: %u", TEST_NUM_OF_DEGS);
+        free(degs);
+        free(turns);
+        return 0;
+    }
+    for (i = 0; i < TEST_NUM_OF_DEGS; i++) {
+        double r;
+        seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+        r = (double)seed / 0x7FFFFFFF - 0.5;
+        switch (i % 6) {
+        case 0:
+            degs[i] = r * 720.0;
+            break;
+        case 1:
+            degs[i] = r * 1e6;
+            break;
+        case 2:
+            /* around 2**52 where the SIMD code falls back to conv_deg_to_turn() */
+            degs[i] = r * 1.8e16;
+            break;
+        case 3:
+            degs[i] = 360.0 * (double)(long)(r * 2000.0);
+            break;
+        case 4:
+            degs[i] = nextafter(360.0 * (double)(long)(r * 2000.0), r > 0 ? 1e300 : -1e300);
+            break;
+        default:
+            degs[i] = r > 0 ? nextafter(360.0, 0.0) : nextafter(-360.0, 0.0);
+            break;
+        }
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH && success; bit_width++) {
+        conv_degs_to_turns(degs, TEST_NUM_OF_DEGS, bit_width, turns);
+        for (i = 0; i < TEST_NUM_OF_DEGS; i++) {
+            const unsigned int expected = conv_deg_to_turn(degs[i], bit_width);
+            if (turns[i] != expected) {
+                ERROR("Observed turn is mismatched",
+                      "degree: %.17g", degs[i],
+                      "bit_width: %u", bit_width,
+                      "expected turn: %u", expected,
+                      "observed turn: %u", turns[i]);
+                success = 0;
+                break;
+            }
+        }
+    }
+    free(degs);
+    free(turns);
+    return success;
+}
+
+
+
+/** Check the statistics of the calls in the current thread, which are collected if the library is built with SERDES_TURN_DEG_STATS. */
+int test_stats(void)
+{
+    static const struct serdes_turn_deg_stats zero_stats;
+    struct serdes_turn_deg_stats stats;
+    char buf[TEST_BUF_SIZE];
+    int enabled;
+
+    serdes_turn_deg_reset_stats();
+    serialize_turn_to_deg(buf, 1, 16); /* "0.005" */
+    serialize_turn_to_deg_fixed(buf, 7, 8, 0, ' '); /* " 10" by the carry from 9.8 */
+    serialize_turn_to_deg_ps(buf, 1u << 15, 17, 3); /* "90" by the suppression of "90.000" */
+    deserialize_turn_from_deg("  12.3456789012", 16, NULL);
+    deserialize_turn_from_deg("x", 8, NULL);
+    enabled = serdes_turn_deg_get_stats(&stats);
+    if (!enabled) {
+        if (memcmp(&stats, &zero_stats, sizeof(stats)) != 0) {
+            ERROR("Statistics are not 0 while they are disabled",
+                  "carries: %lu", stats.carries);
+            return 0;
+        }
+        return 1;
+    }
+    if (stats.serialized_by_bit_width[16] != 1 || stats.serialized_by_bit_width[8] != 1 || stats.serialized_by_bit_width[17] != 1 ||
+        stats.serialized_shortest != 1 ||
+        stats.serialized_by_precision[0 - SERDES_TURN_DEG_MIN_PRECISION] != 1 || stats.serialized_by_precision[3 - SERDES_TURN_DEG_MIN_PRECISION] != 1 ||
+        stats.serialized_length[5] != 1 || stats.serialized_length[3] != 1 || stats.serialized_length[2] != 1) {
+        ERROR("Statistics of the serialization are mismatched",
+              "angles in 16 bits: %lu", stats.serialized_by_bit_width[16],
+              "shortest: %lu", stats.serialized_shortest,
+              "precision 3: %lu", stats.serialized_by_precision[3 - SERDES_TURN_DEG_MIN_PRECISION],
+              "length 5: %lu", stats.serialized_length[5]);
+        return 0;
+    }
+    if (stats.carries != 1 || stats.suppressions != 1) {
+        ERROR("Statistics of the carries and the suppressions are mismatched",
+              "carries: %lu (expected 1)", stats.carries,
+              "suppressions: %lu (expected 1)", stats.suppressions);
+        return 0;
+    }
+    if (stats.deserialized_by_bit_width[16] != 1 || stats.parsed_length[15] != 1 || stats.parsed_length[0] != 1 ||
+        stats.truncated_digits != 10 - SERDES_TURN_DEG_MAX_PRECISION || stats.no_digits != 1) {
+        ERROR("Statistics of the deserialization are mismatched",
+              "angles in 16 bits: %lu", stats.deserialized_by_bit_width[16],
+              "length 15: %lu", stats.parsed_length[15],
+              "truncated digits: %lu", stats.truncated_digits,
+              "no digits: %lu", stats.no_digits);
+        return 0;
+    }
+
+    serdes_turn_deg_reset_stats();
+    serdes_turn_deg_get_stats(&stats);
+    if (memcmp(&stats, &zero_stats, sizeof(stats)) != 0) {
+        ERROR("Statistics are not reset",
+              "carries: %lu", stats.carries);
+        return 0;
+    }
+    return 1;
+}
+
+
+/** The number of the turns in a work item. */
+#define TEST_WORK_NUM_OF_TURNS (1ul << 16)
+
+/** A work item of the exhaustive tests, which can run in parallel with the others. */
+struct TestWork {
+    int (*func)(const struct TestWork *work);
+    unsigned int bit_width;
+    int precision;
+    /** The range of the index for test_turn(). */
+    unsigned long begin;
+    unsigned long end;
+};
+
+/** The work items and the state to run them. */
+struct TestWorkList {
+    struct TestWork *works;
+    size_t num;
+    size_t capacity;
+    /** The number of the combinations of a test and bit-width (and precision) so far, which identifies the shard. */
+    unsigned long num_of_combinations;
+    unsigned long shard_index;
+    unsigned long shard_count;
+    /** The next work item to run. */
+    size_t next;
+    int failed;
+    pthread_mutex_t mutex;
+};
+
+int run_recoverable_serialize_turn_to_deg(const struct TestWork *work)
+{
+    return test_recoverable_serialize_turn_to_deg(work->bit_width, work->begin, work->end);
+}
+
+int run_recoverable_serialize_turn_to_deg_p(const struct TestWork *work)
+{
+    return test_recoverable_serialize_turn_to_deg_p(work->bit_width, work->precision, work->begin, work->end);
+}
+
+int run_recoverable_serialize_turn_to_deg_ps(const struct TestWork *work)
+{
+    return test_recoverable_serialize_turn_to_deg_ps(work->bit_width, work->precision, work->begin, work->end);
+}
+
+int run_serialized_strings_hash(const struct TestWork *work)
+{
+    (void)work;
+    return test_serialized_strings_hash();
+}
+
+int run_serialize_turns_to_deg(const struct TestWork *work)
+{
+    return test_serialize_turns_to_deg(work->bit_width, work->precision);
+}
+
+int run_recoverable_deserialize_turns_from_deg(const struct TestWork *work)
+{
+    return test_recoverable_deserialize_turns_from_deg(work->bit_width);
+}
+
+/** Add a combination of a test and bit-width (and precision) if it's in the shard.
+    \param [in] num_of_turns The number of the turns to split into the work items, or 0 not to split.
+    \return 0 if it's out of memory.
+*/
+int add_test_works(struct TestWorkList *list, int (*func)(const struct TestWork *), const unsigned int bit_width, const int precision, const unsigned long num_of_turns)
+{
+    unsigned long begin = 0;
+    if (list->num_of_combinations++ % list->shard_count != list->shard_index) {
+        return 1;
+    }
+    do {
+        struct TestWork *work;
+        if (list->num == list->capacity) {
+            const size_t capacity = list->capacity == 0 ? 256 : list->capacity * 2;
+            struct TestWork *works = realloc(list->works, capacity * sizeof(works[0]));
+            if (works == NULL) {
+                ERROR("Out of memory",
+                      "number of work items: %lu", (unsigned long)capacity);
+                return 0;
+            }
+            list->works = works;
+            list->capacity = capacity;
+        }
+        work = &list->works[list->num++];
+        work->func = func;
+        work->bit_width = bit_width;
+        work->precision = precision;
+        work->begin = begin;
+        work->end = num_of_turns - begin > TEST_WORK_NUM_OF_TURNS ? begin + TEST_WORK_NUM_OF_TURNS : num_of_turns;
+        begin = work->end;
+    } while (begin < num_of_turns);
+    return 1;
+}
+
+void *test_worker(void *arg)
+{
+    struct TestWorkList *list = arg;
+    for (;;) {
+        const struct TestWork *work = NULL;
+        pthread_mutex_lock(&list->mutex);
+        if (!list->failed && list->next < list->num) {
+            work = &list->works[list->next++];
+        }
+        pthread_mutex_unlock(&list->mutex);
+        if (work == NULL) {
+            break;
+        }
+        if (!work->func(work)) {
+            pthread_mutex_lock(&list->mutex);
+            list->failed = 1;
+            pthread_mutex_unlock(&list->mutex);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/** Run the work items on the threads.
+    \return 1 if all the work items succeed.
+*/
+int run_test_works(struct TestWorkList *list, const unsigned int num_of_threads)
+{
+    pthread_t *threads = malloc(num_of_threads * sizeof(threads[0]));
+    unsigned int n = 0;
+    if (threads != NULL) {
+        /* The main thread is the last worker. */
+        for (; n + 1 < num_of_threads; n++) {
+            if (pthread_create(&threads[n], NULL, test_worker, list) != 0) {
+                break;
+            }
+        }
+    }
+    test_worker(list);
+    while (n > 0) {
+        pthread_join(threads[--n], NULL);
+    }
+    free(threads);
+    return !list->failed;
+}
+
+
+int run_recoverable_serialize_turn_to_deg_fixed(const struct TestWork *work)
+{
+    return test_recoverable_serialize_turn_to_deg_fixed(work->bit_width, work->begin, work->end);
+}
+
+void usage()
+{
+    fputs("Usage: test_serdes_turn_deg [-j THREADS] [--shard INDEX/COUNT] [--max-bit-width BIT_WIDTH]\n", stderr);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int bit_width;
+    int precision;
+    long num_of_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_bit_width = TEST_MAX_BIT_WIDTH;
+    struct TestWorkList list;
+    int success = 1;
+    int i;
+
+    memset(&list, 0, sizeof(list));
+    list.shard_count = 1;
+    for (i = 1; i < argc; i++) {
+        char *end;
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            num_of_threads = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || num_of_threads <= 0) {
+                usage();
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+            list.shard_index = strtoul(argv[++i], &end, 10);
+            if (*end != '/') {
+                usage();
+                return 1;
+            }
+            list.shard_count = strtoul(end + 1, &end, 10);
+            if (*end != '\0' || list.shard_count == 0 || list.shard_index >= list.shard_count) {
+                usage();
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--max-bit-width") == 0 && i + 1 < argc) {
+            const unsigned long value = strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || value < SERDES_TURN_DEG_MIN_BIT_WIDTH || value > TEST_MAX_BIT_WIDTH) {
+                usage();
+                return 1;
+            }
+            max_bit_width = (unsigned int)value;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (num_of_threads <= 0) {
+        num_of_threads = 1;
+    }
+
+    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg()\n", stdout);
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= max_bit_width; bit_width++) {
+        success = add_test_works(&list, run_recoverable_serialize_turn_to_deg, bit_width, 0, num_of_test_turns(bit_width));
+    }
+
+    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg_p()\n", stdout);
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= max_bit_width; bit_width++) {
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; success && precision <= TEST_MAX_PRECISION; precision++) {
+            success = add_test_works(&list, run_recoverable_serialize_turn_to_deg_p, bit_width, precision, num_of_test_turns(bit_width));
+        }
+    }
+
+    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg_ps()\n", stdout);
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= max_bit_width; bit_width++) {
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; success && precision <= TEST_MAX_PRECISION; precision++) {
+            success = add_test_works(&list, run_recoverable_serialize_turn_to_deg_ps, bit_width, precision, num_of_test_turns(bit_width));
+        }
+    }
+
+    fputs("Testing: Serialize and then Deserialize: serialize_turn_to_deg_fixed()\n", stdout);
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= max_bit_width; bit_width++) {
+        success = add_test_works(&list, run_recoverable_serialize_turn_to_deg_fixed, bit_width, 0, num_of_test_turns(bit_width));
+    }
+
+    /* The expected hashes are for all the bit-widths. */
+    if (max_bit_width == TEST_MAX_BIT_WIDTH) {
+        fputs("Testing: Digit Engine: the hash of the serialized strings\n", stdout);
+        if (success) {
+            success = add_test_works(&list, run_serialized_strings_hash, 0, 0, 0);
+        }
+    }
+
+    fputs("Testing: Batch: serialize_turns_to_deg*()\n", stdout);
+    /* All angles up to 22 bits, where the batch functions may use the SIMD kernel, but some precisions for the large bit-widths */
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= 22 && bit_width <= max_bit_width; bit_width++) {
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; success && precision <= TEST_MAX_PRECISION; precision++) {
+            if (bit_width <= 16 || precision == SERDES_TURN_DEG_MIN_PRECISION || precision == 0 || precision == 3 || precision == TEST_MAX_PRECISION) {
+                success = add_test_works(&list, run_serialize_turns_to_deg, bit_width, precision, 0);
+            }
+        }
+    }
+
+    fputs("Testing: Serialize and then Deserialize: deserialize_turns_from_deg()\n", stdout);
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= 16 && bit_width <= max_bit_width; bit_width++) {
+        success = add_test_works(&list, run_recoverable_deserialize_turns_from_deg, bit_width, 0, 0);
+    }
+
+    if (success) {
+        printf("Running %lu work items of shard %lu/%lu on %ld threads\n",
+               (unsigned long)list.num, list.shard_index, list.shard_count, num_of_threads);
+        pthread_mutex_init(&list.mutex, NULL);
+        success = run_test_works(&list, (unsigned int)num_of_threads);
+        pthread_mutex_destroy(&list.mutex);
+    }
+    free(list.works);
+    if (!success) {
+        return 1;
+    }
+
+    /* The tests below are quick, so they run in every shard. */
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg()\n", stdout);
+    if (!test_serialize_turn_to_deg(test_for_serialize_turn_to_deg, NUM_OF(test_for_serialize_turn_to_deg))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_p()\n", stdout);
+    if (!test_serialize_turn_to_deg_p(test_for_serialize_turn_to_deg_p, NUM_OF(test_for_serialize_turn_to_deg_p))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_ps()\n", stdout);
+    if (!test_serialize_turn_to_deg_ps(test_for_serialize_turn_to_deg_ps, NUM_OF(test_for_serialize_turn_to_deg_ps))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_fixed()\n", stdout);
+    if (!test_deg_fixed_min_precision()) {
+        return 1;
+    }
+    if (!test_serialize_turn_to_deg_fixed(test_for_serialize_turn_to_deg_fixed, NUM_OF(test_for_serialize_turn_to_deg_fixed))) {
+        return 1;
+    }
+    if (!test_serialize_turn_to_deg_fixed_rejected()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_length()\n", stdout);
+    if (!test_serialize_turn_to_deg_length()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_multi()\n", stdout);
+    if (!test_serialize_turn_to_deg_multi()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turns_to_deg*() of any number\n", stdout);
+    if (!test_serialize_turns_to_deg_tails()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: conv_turn_to_deg_decimal()\n", stdout);
+    if (!test_conv_turn_to_deg_decimal()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_bcd()\n", stdout);
+    if (!test_serialize_turn_to_deg_bcd()) {
+        return 1;
+    }
+    if (!test_deserialize_turn_from_deg_bcd(test_for_deserialize_turn_from_deg_bcd, NUM_OF(test_for_deserialize_turn_from_deg_bcd))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: serialize_turn_to_deg_incremental()\n", stdout);
+    if (!test_serialize_turn_to_deg_incremental()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: deserialize_turn_from_deg()\n", stdout);
+    if (!test_deserialize_turn_from_deg(test_for_deserialize_turn_from_deg, NUM_OF(test_for_deserialize_turn_from_deg))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: deserialize_turn_from_deg_n()\n", stdout);
+    if (!test_deserialize_turn_from_deg_n_same_as_nul(test_for_deserialize_turn_from_deg, NUM_OF(test_for_deserialize_turn_from_deg))) {
+        return 1;
+    }
+    if (!test_deserialize_turn_from_deg_n(test_for_deserialize_turn_from_deg_n, NUM_OF(test_for_deserialize_turn_from_deg_n))) {
+        return 1;
+    }
+    if (!test_deserialize_turn_from_deg_random_texts()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: deserialize_turns_from_deg()\n", stdout);
+    if (!test_deserialize_turns_from_deg(test_for_deserialize_turn_from_deg, NUM_OF(test_for_deserialize_turn_from_deg), ',')) {
+        return 1;
+    }
+    if (!test_deserialize_turns_from_deg(test_for_deserialize_turn_from_deg, NUM_OF(test_for_deserialize_turn_from_deg), '\n')) {
+        return 1;
+    }
+
+    fputs("Testing: Streaming: deserialize_turns_from_deg_chunk()\n", stdout);
+    if (!test_deserialize_turns_from_deg_chunk()) {
+        return 1;
+    }
+
+    fputs("Testing: Thresholds: deserialize_turn_from_deg()\n", stdout);
+    if (!test_deserialize_turn_from_deg_thresholds()) {
+        return 1;
+    }
+
+    fputs("Testing: Parallel: serialize_turns_to_deg_parallel()\n", stdout);
+    if (!test_serialize_turns_to_deg_parallel()) {
+        return 1;
+    }
+
+    fputs("Testing: Parallel: deserialize_turns_from_deg_parallel()\n", stdout);
+    if (!test_deserialize_turns_from_deg_parallel()) {
+        return 1;
+    }
+
+    fputs("Testing: Resolution\n", stdout);
+    if (!test_deg_is_just_integer()) {
+        return 1;
+    }
+
+    fputs("Testing: Statistics\n", stdout);
+    if (!test_stats()) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: conv_deg_to_turn()\n", stdout);
+    if (!test_conv_deg_to_turn(test_for_conv_deg_to_turn, NUM_OF(test_for_conv_deg_to_turn))) {
+        return 1;
+    }
+
+    fputs("Testing: Certain Patterns: conv_degs_to_turns()\n", stdout);
+    if (!test_conv_degs_to_turns()) {
         return 1;
     }
 
@@ -0,0 +1,315 @@
+/* Unit Test for the C++ interface of serdes_turn_deg.
+
+  Copyright © 2023 OOTA, Masato
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "serdes_turn_deg.hpp"
+
+/* Serialize at compile time. */
+static_assert(serdes_turn::serialize<16>(0u).equals("0"), "serialize<16>(0)");
+static_assert(serdes_turn::serialize<16>(16384u).equals("90"), "serialize<16>(16384)");
+static_assert(serdes_turn::serialize<16>(1u).equals("0.005"), "serialize<16>(1)");
+static_assert(serdes_turn::serialize_p<12, 2>(0u).equals("0.00"), "serialize_p<12, 2>(0)");
+static_assert(serdes_turn::serialize_p<8, -1>(128u).equals("180"), "serialize_p<8, -1>(128)");
+static_assert(serdes_turn::serialize_ps<12, 3>(1024u).equals("90"), "serialize_ps<12, 3>(1024)");
+static_assert(serdes_turn::serialize_ps<12, 3>(1u).equals("0.088"), "serialize_ps<12, 3>(1)");
+#ifdef SERDES_TURN_DEG_WIDE
+static_assert(serdes_turn::serialize<32>(4294967295u).equals("359.9999999"), "serialize<32>(4294967295)");
+#endif
+
+/** Check to_chars() at compile time. */
+constexpr bool to_chars_equals(const std::size_t size, const unsigned int turn, const char *expected, const std::errc expected_ec)
+{
+    char buf[SERDES_TURN_DEG_WIDE_BUF_SIZE] = {};
+    const std::to_chars_result result = serdes_turn::to_chars_p<16, 1>(buf, buf + size, turn);
+    if (result.ec != expected_ec) {
+        return false;
+    }
+    if (result.ec != std::errc()) {
+        return result.ptr == buf + size;
+    }
+    return std::string_view(buf, static_cast<std::size_t>(result.ptr - buf)) == expected;
+}
+static_assert(to_chars_equals(sizeof("90.0") - 1, 16384u, "90.0", std::errc()), "to_chars_p<16, 1>(16384) to the exact buffer");
+static_assert(to_chars_equals(sizeof("90.0") - 2, 16384u, "", std::errc::value_too_large), "to_chars_p<16, 1>(16384) to the short buffer");
+static_assert(to_chars_equals(SERDES_TURN_DEG_WIDE_BUF_SIZE, 1u, "0.005", std::errc()), "to_chars_p<16, 1>(1)");
+
+/** The maximum bit-width to test all turns. */
+#define TEST_MAX_EXHAUSTIVE_BIT_WIDTH 16
+/** The number of the turns to test in a bit-width more than TEST_MAX_EXHAUSTIVE_BIT_WIDTH. */
+#define TEST_NUM_OF_SAMPLE_TURNS (1ul << 16)
+
+/** The kind of the function. */
+enum {
+    KIND_SHORTEST,
+    KIND_P,
+    KIND_PS
+};
+
+static const char *const kind_name[] = {
+    "serialize",
+    "serialize_p",
+    "serialize_ps",
+};
+
+template <unsigned int BitWidth, int Precision, int Kind>
+static char *serialize_cpp(char *buf, const unsigned int turn)
+{
+    if constexpr (Kind == KIND_SHORTEST) {
+        return serdes_turn::serialize<BitWidth>(buf, turn);
+    } else if constexpr (Kind == KIND_P) {
+        return serdes_turn::serialize_p<BitWidth, Precision>(buf, turn);
+    } else {
+        return serdes_turn::serialize_ps<BitWidth, Precision>(buf, turn);
+    }
+}
+
+template <unsigned int BitWidth, int Precision, int Kind>
+static serdes_turn::deg_string serialize_cpp_string(const unsigned int turn)
+{
+    if constexpr (Kind == KIND_SHORTEST) {
+        return serdes_turn::serialize<BitWidth>(turn);
+    } else if constexpr (Kind == KIND_P) {
+        return serdes_turn::serialize_p<BitWidth, Precision>(turn);
+    } else {
+        return serdes_turn::serialize_ps<BitWidth, Precision>(turn);
+    }
+}
+
+static char *serialize_c(char *buf, const unsigned int turn, const unsigned int bit_width, const int precision, const int kind)
+{
+    switch (kind) {
+    case KIND_SHORTEST:
+        return serialize_turn_to_deg(buf, turn, bit_width);
+    case KIND_P:
+        return serialize_turn_to_deg_p(buf, turn, bit_width, precision);
+    default:
+        return serialize_turn_to_deg_ps(buf, turn, bit_width, precision);
+    }
+}
+
+/** Compare the C++ function with the C function for all turns (or the samples). */
+template <unsigned int BitWidth, int Precision, int Kind>
+static bool test_same_as_c()
+{
+    const unsigned long num = BitWidth <= TEST_MAX_EXHAUSTIVE_BIT_WIDTH ? 1ul << BitWidth : TEST_NUM_OF_SAMPLE_TURNS;
+    const unsigned long step = (1ul << BitWidth) / num;
+    for (unsigned long n = 0; n < num; n++) {
+        /* The samples contain the maximum turn. */
+        const unsigned int turn = static_cast<unsigned int>(n == num - 1 ? (1ul << BitWidth) - 1 : n * step);
+        char expected[SERDES_TURN_DEG_WIDE_BUF_SIZE];
+        char observed[SERDES_TURN_DEG_WIDE_BUF_SIZE];
+        const char *const expected_end = serialize_c(expected, turn, BitWidth, Precision, Kind);
+        const char *const observed_end = serialize_cpp<BitWidth, Precision, Kind>(observed, turn);
+        const serdes_turn::deg_string str = serialize_cpp_string<BitWidth, Precision, Kind>(turn);
+        if (std::strcmp(expected, observed) != 0 || observed_end - observed != expected_end - expected ||
+            str.view() != expected) {
+            std::printf("Error in %s() (%s:%u): String mismatch: function: %s, bit_width: %u, precision: %d, turn: %u, expected: %s, observed: %s\n",
+                        __func__, __FILE__, __LINE__, kind_name[Kind], BitWidth, Precision, turn, expected, observed);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <unsigned int BitWidth, int Precision, int Kind>
+static std::to_chars_result to_chars_cpp(char *first, char *last, const unsigned int turn)
+{
+    if constexpr (Kind == KIND_SHORTEST) {
+        return serdes_turn::to_chars<BitWidth>(first, last, turn);
+    } else if constexpr (Kind == KIND_P) {
+        return serdes_turn::to_chars_p<BitWidth, Precision>(first, last, turn);
+    } else {
+        return serdes_turn::to_chars_ps<BitWidth, Precision>(first, last, turn);
+    }
+}
+
+/** The same as to_chars_cpp(), but the overloads that take the bit-width and the precision at run time. */
+static std::to_chars_result to_chars_runtime(char *first, char *last, const unsigned int turn, const unsigned int bit_width, const int precision, const int kind)
+{
+    switch (kind) {
+    case KIND_SHORTEST:
+        return serdes_turn::to_chars(first, last, turn, bit_width);
+    case KIND_P:
+        return serdes_turn::to_chars_p(first, last, turn, bit_width, precision);
+    default:
+        return serdes_turn::to_chars_ps(first, last, turn, bit_width, precision);
+    }
+}
+
+/** Compare to_chars() with the C function for the buffers of all lengths, and check that from_chars() recovers the turn. */
+template <unsigned int BitWidth, int Precision, int Kind>
+static bool test_to_chars()
+{
+    const unsigned long num = BitWidth <= 12 ? 1ul << BitWidth : 4096;
+    const unsigned long step = (1ul << BitWidth) / num;
+    for (unsigned long n = 0; n < num; n++) {
+        const unsigned int turn = static_cast<unsigned int>(n * step);
+        char expected[SERDES_TURN_DEG_WIDE_BUF_SIZE];
+        const std::size_t expected_len = static_cast<std::size_t>(serialize_c(expected, turn, BitWidth, Precision, Kind) - expected);
+        for (std::size_t size = 0; size <= SERDES_TURN_DEG_WIDE_BUF_SIZE; size++) {
+            /* The buffer for the longest string and NUL is written directly with NUL. */
+            const bool direct = static_cast<std::ptrdiff_t>(size) >= serdes_turn::detail::buf_size(BitWidth, Kind == KIND_SHORTEST ? serdes_turn::detail::max_place : -Precision);
+            const bool fits = expected_len <= size;
+            for (int runtime = 0; runtime < 2; runtime++) {
+                char buf[SERDES_TURN_DEG_WIDE_BUF_SIZE + 1];
+                std::memset(buf, '#', sizeof(buf));
+                const std::to_chars_result result = runtime ? to_chars_runtime(buf, buf + size, turn, BitWidth, Precision, Kind) : to_chars_cpp<BitWidth, Precision, Kind>(buf, buf + size, turn);
+                const char after = buf[fits ? expected_len : size];
+                if (result.ec != (fits ? std::errc() : std::errc::value_too_large) ||
+                    result.ptr != buf + (fits ? expected_len : size) ||
+                    (fits && std::memcmp(buf, expected, expected_len) != 0) || (after != '#' && !(direct && after == '\0'))) {
+                    std::printf("Error in %s() (%s:%u): to_chars mismatch: function: %s, bit_width: %u, precision: %d, turn: %u, size: %u, runtime: %d, expected: %s\n",
+                                __func__, __FILE__, __LINE__, kind_name[Kind], BitWidth, Precision, turn, static_cast<unsigned int>(size), runtime, expected);
+                    return false;
+                }
+            }
+        }
+        unsigned int recovered = ~turn;
+        const std::from_chars_result result = serdes_turn::from_chars<BitWidth>(expected, expected + expected_len, recovered);
+        unsigned int recovered_runtime = ~turn;
+        const std::from_chars_result result_runtime = serdes_turn::from_chars(expected, expected + expected_len, recovered_runtime, BitWidth);
+        if (result.ec != std::errc() || result.ptr != expected + expected_len || recovered != turn ||
+            result_runtime.ec != std::errc() || result_runtime.ptr != result.ptr || recovered_runtime != turn) {
+            std::printf("Error in %s() (%s:%u): from_chars isn't recoverable: bit_width: %u, turn: %u, text: %s, recovered: %u\n",
+                        __func__, __FILE__, __LINE__, BitWidth, turn, expected, recovered);
+            return false;
+        }
+    }
+    return true;
+}
+
+/** A text and the expected result of from_chars(). */
+struct TestFromChars {
+    const char *text;
+    std::size_t ptr; /**< The expected offset of ptr. */
+    std::errc ec;
+    const char *same_as; /**< The text that results in the same turn, or nullptr if the turn is unchanged. */
+};
+
+static bool test_from_chars()
+{
+    static const TestFromChars table[] = {
+        { "90", 2, std::errc(), "90" },
+        { " 90.5x", 5, std::errc(), "90.5" },
+        { "450", 3, std::errc(), "90" },
+        { ".5", 2, std::errc(), "0.5" },
+        { "1.", 2, std::errc(), "1" },
+        { "", 0, std::errc::invalid_argument, nullptr },
+        { "  ", 0, std::errc::invalid_argument, nullptr },
+        { ".", 0, std::errc::invalid_argument, nullptr },
+        { "x1", 0, std::errc::invalid_argument, nullptr },
+        { "1234", 3, std::errc::result_out_of_range, nullptr },
+    };
+    for (const TestFromChars &entry : table) {
+        const std::size_t len = std::strlen(entry.text);
+        /* The character after the text must not be read. */
+        char text[16];
+        std::memcpy(text, entry.text, len);
+        text[len] = '7';
+        unsigned int turn = 12345u;
+        const std::from_chars_result result = serdes_turn::from_chars<16>(text, text + len, turn);
+        const unsigned int expected_turn = entry.same_as != nullptr ? deserialize_turn_from_deg(entry.same_as, 16, nullptr) : 12345u;
+        if (result.ptr != text + entry.ptr || result.ec != entry.ec || turn != expected_turn) {
+            std::printf("Error in %s() (%s:%u): from_chars mismatch: text: %s, expected offset: %u, observed offset: %d, expected turn: %u, observed turn: %u\n",
+                        __func__, __FILE__, __LINE__, entry.text, static_cast<unsigned int>(entry.ptr), static_cast<int>(result.ptr - text), expected_turn, turn);
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef __cpp_lib_span
+/** Compare the overloads for std::span with the batch functions of C. */
+static bool test_span()
+{
+    unsigned int turns[100];
+    for (unsigned int i = 0; i < 100; i++) {
+        turns[i] = (i * 2654435761u) & 0xFFFFu;
+    }
+    char expected[SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(100)];
+    char buf[SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(100)];
+    const std::size_t expected_len = static_cast<std::size_t>(serialize_turns_to_deg_ps(expected, turns, 100, 16, 3, ',') - expected);
+    const std::to_chars_result result = serdes_turn::to_chars_ps<16, 3>(buf, buf + sizeof(buf), std::span<const unsigned int>(turns), ',');
+    if (result.ec != std::errc() || result.ptr != buf + expected_len || std::memcmp(buf, expected, expected_len) != 0) {
+        std::printf("Error in %s() (%s:%u): to_chars_ps of span mismatch\n", __func__, __FILE__, __LINE__);
+        return false;
+    }
+    if (serdes_turn::to_chars_ps<16, 3>(buf, buf + expected_len - 1, std::span<const unsigned int>(turns), ',').ec != std::errc::value_too_large) {
+        std::printf("Error in %s() (%s:%u): to_chars_ps of span to the short buffer isn't an error\n", __func__, __FILE__, __LINE__);
+        return false;
+    }
+
+    unsigned int recovered[101];
+    const serdes_turn::from_chars_turns_result all = serdes_turn::from_chars<16>(expected, expected + expected_len, std::span<unsigned int>(recovered), ',');
+    if (all.ec != std::errc() || all.ptr != expected + expected_len || all.num != 100 || std::memcmp(recovered, turns, sizeof(turns)) != 0) {
+        std::printf("Error in %s() (%s:%u): from_chars of span mismatch: num: %u\n", __func__, __FILE__, __LINE__, static_cast<unsigned int>(all.num));
+        return false;
+    }
+    const serdes_turn::from_chars_turns_result part = serdes_turn::from_chars<16>(expected, expected + expected_len, std::span<unsigned int>(recovered, 2), ',');
+    if (part.ec != std::errc() || part.num != 2 || part.ptr != std::strchr(std::strchr(expected, ',') + 1, ',') + 1) {
+        std::printf("Error in %s() (%s:%u): from_chars of span doesn't stop at the size\n", __func__, __FILE__, __LINE__);
+        return false;
+    }
+    static const char malformed[] = "90,1.5x,2";
+    const serdes_turn::from_chars_turns_result error = serdes_turn::from_chars<16>(malformed, malformed + sizeof(malformed) - 1, std::span<unsigned int>(recovered), ',');
+    if (error.ec != std::errc::invalid_argument || error.num != 1 || error.ptr != malformed + 6) {
+        std::printf("Error in %s() (%s:%u): from_chars of span doesn't stop at the malformed field: num: %u\n", __func__, __FILE__, __LINE__, static_cast<unsigned int>(error.num));
+        return false;
+    }
+    return true;
+}
+#endif
+
+template <unsigned int BitWidth, int... Offsets>
+static bool test_bit_width(std::integer_sequence<int, Offsets...>)
+{
+    return test_same_as_c<BitWidth, 0, KIND_SHORTEST>() &&
+        (test_same_as_c<BitWidth, SERDES_TURN_DEG_MIN_PRECISION + Offsets, KIND_P>() && ...) &&
+        (test_same_as_c<BitWidth, SERDES_TURN_DEG_MIN_PRECISION + Offsets, KIND_PS>() && ...) &&
+        test_to_chars<BitWidth, 0, KIND_SHORTEST>() &&
+        (test_to_chars<BitWidth, SERDES_TURN_DEG_MIN_PRECISION + Offsets, KIND_P>() && ...) &&
+        (test_to_chars<BitWidth, SERDES_TURN_DEG_MIN_PRECISION + Offsets, KIND_PS>() && ...);
+}
+
+template <unsigned int... Offsets>
+static bool test_all_bit_widths(std::integer_sequence<unsigned int, Offsets...>)
+{
+    using precisions = std::make_integer_sequence<int, serdes_turn::detail::max_precision - SERDES_TURN_DEG_MIN_PRECISION + 1>;
+    return (test_bit_width<SERDES_TURN_DEG_MIN_BIT_WIDTH + Offsets>(precisions()) && ...);
+}
+
+int main()
+{
+    std::fputs("Testing: C++: serialize*() is the same as serialize_turn_to_deg*()\n", stdout);
+    if (!test_all_bit_widths(std::make_integer_sequence<unsigned int, serdes_turn::detail::max_bit_width - SERDES_TURN_DEG_MIN_BIT_WIDTH + 1>())) {
+        return 1;
+    }
+    std::fputs("Testing: C++: from_chars()\n", stdout);
+    if (!test_from_chars()) {
+        return 1;
+    }
+#ifdef __cpp_lib_span
+    std::fputs("Testing: C++: to_chars() and from_chars() of std::span\n", stdout);
+    if (!test_span()) {
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,277 @@
+/* Unit Test for the SIMD kernels of serdes_turn_deg.
+
+  Copyright © 2023 OOTA, Masato
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  This test and the library are built with -mavx2 or -mavx512f. The batch functions run the SIMD kernels, and the functions for an angle run the scalar code, so their results must be the same for every bit-width.
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "serdes_turn_deg.h"
+
+#ifndef __AVX2__
+#error "Build this test and the library with -mavx2 or -mavx512f."
+#endif
+
+#define ERROR(error_msg, ...) \
+    printf("Error in %s() (%s:%u): " error_msg "\n", __func__, __FILE__, __LINE__, __VA_ARGS__)
+
+#define NUM_OF(a) (sizeof(a)/sizeof(a[0]))
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the library accepts in this build. */
+#define TEST_MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the library accepts in this build. */
+#define TEST_MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length to serialize num angles at once for TEST_MAX_BIT_WIDTH and TEST_MAX_PRECISION. */
+#define TEST_BATCH_BUF_SIZE(num) SERDES_TURN_DEG_WIDE_BATCH_BUF_SIZE(num)
+#else
+#define TEST_MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define TEST_MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define TEST_BATCH_BUF_SIZE(num) SERDES_TURN_DEG_BATCH_BUF_SIZE(num)
+#endif
+
+/** The exit status that tells the test runner that the test is skipped. */
+#define EXIT_SKIP 77
+
+/** The maximum bit-width to test all turns. */
+#define TEST_MAX_EXHAUSTIVE_BIT_WIDTH 12
+/** The number of the turns to test in a bit-width more than TEST_MAX_EXHAUSTIVE_BIT_WIDTH. */
+#define TEST_NUM_OF_SAMPLE_TURNS 4096
+/** The maximum number of the angles to test the tails that aren't a multiple of the SIMD lanes. */
+#define TEST_MAX_TAIL 17
+/** The number of the degrees for each bit-width, which isn't a multiple of the SIMD lanes. */
+#define TEST_NUM_OF_DEGS 4099
+
+
+/** The number of the turns to test in a bit-width. */
+static unsigned long num_of_test_turns(const unsigned int bit_width)
+{
+    return bit_width <= TEST_MAX_EXHAUSTIVE_BIT_WIDTH ? 1ul << bit_width : TEST_NUM_OF_SAMPLE_TURNS;
+}
+
+/** The n-th turn to test, which is all turns or the samples that contain 0, the maximum, and the half. */
+static unsigned int test_turn(const unsigned long n, const unsigned int bit_width)
+{
+    const unsigned int mask = (unsigned int)((2ul << (bit_width - 1)) - 1);
+    if (bit_width <= TEST_MAX_EXHAUSTIVE_BIT_WIDTH) {
+        return (unsigned int)n;
+    }
+    switch (n) {
+    case 0:
+        return 0;
+    case 1:
+        return mask;
+    case 2:
+        return 1u << (bit_width - 1);
+    default:
+        /* The lanes stop at the different places. */
+        return (unsigned int)((n * 2654435761ul) & 0xFFFFFFFFul) >> (32 - bit_width);
+    }
+}
+
+
+/** Serialize the angles one by one by the scalar code, the same as the batch function of mode.
+    \return The point to NUL character in buf.
+*/
+static char *serialize_one_by_one(char *buf, const unsigned int *const turns, const size_t num, const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision)
+{
+    size_t i;
+    *buf = '\0';
+    for (i = 0; i < num; i++) {
+        if (i > 0) {
+            *buf++ = ',';
+        }
+        switch (mode) {
+        case SERDES_TURN_DEG_MODE_SHORTEST:
+            buf = serialize_turn_to_deg(buf, turns[i], bit_width);
+            break;
+        case SERDES_TURN_DEG_MODE_P:
+            buf = serialize_turn_to_deg_p(buf, turns[i], bit_width, precision);
+            break;
+        default:
+            buf = serialize_turn_to_deg_ps(buf, turns[i], bit_width, precision);
+            break;
+        }
+    }
+    return buf;
+}
+
+/** Serialize the angles at once by the batch function of mode, which uses the AVX2 kernel.
+    \return The point to NUL character in buf.
+*/
+static char *serialize_batch(char *buf, const unsigned int *const turns, const size_t num, const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision)
+{
+    switch (mode) {
+    case SERDES_TURN_DEG_MODE_SHORTEST:
+        return serialize_turns_to_deg(buf, turns, num, bit_width, ',');
+    case SERDES_TURN_DEG_MODE_P:
+        return serialize_turns_to_deg_p(buf, turns, num, bit_width, precision, ',');
+    default:
+        return serialize_turns_to_deg_ps(buf, turns, num, bit_width, precision, ',');
+    }
+}
+
+/** Compare the batch serialization by AVX2 with the scalar code for a mode and a precision, for all the angles and the tails. */
+static int test_serialize_mode(char *const expected, char *const observed, const unsigned int *const turns, const size_t num, const unsigned int bit_width, const enum serdes_turn_deg_mode mode, const int precision)
+{
+    size_t n;
+    for (n = 1; n <= num; n = n < TEST_MAX_TAIL ? n + 1 : num) {
+        const char *const expected_end = serialize_one_by_one(expected, turns, n, bit_width, mode, precision);
+        const char *const observed_end = serialize_batch(observed, turns, n, bit_width, mode, precision);
+        if (observed_end - observed != expected_end - expected || strcmp(expected, observed) != 0) {
+            ERROR("Batch result mismatch: mode: %d, bit_width: %u, precision: %d, number of turns: %u, expected length: %u, observed length: %u",
+                  (int)mode, bit_width, precision, (unsigned int)n, (unsigned int)(expected_end - expected), (unsigned int)(observed_end - observed));
+            return 0;
+        }
+        if (n == num) {
+            break;
+        }
+    }
+    return 1;
+}
+
+/** Compare serialize_turns_to_deg*() by AVX2 with serialize_turn_to_deg*() for every bit-width and precision. */
+static int test_serialize_turns_to_deg(void)
+{
+    const size_t max_num = TEST_NUM_OF_SAMPLE_TURNS > 1ul << TEST_MAX_EXHAUSTIVE_BIT_WIDTH ? TEST_NUM_OF_SAMPLE_TURNS : 1ul << TEST_MAX_EXHAUSTIVE_BIT_WIDTH;
+    unsigned int *const turns = malloc(max_num * sizeof(unsigned int));
+    char *const expected = malloc(TEST_BATCH_BUF_SIZE(max_num));
+    char *const observed = malloc(TEST_BATCH_BUF_SIZE(max_num));
+    unsigned int bit_width;
+    int success = turns != NULL && expected != NULL && observed != NULL;
+    if (!success) {
+        ERROR("Out of memory: number of turns: %u", (unsigned int)max_num);
+    }
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; success && bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        const size_t num = num_of_test_turns(bit_width);
+        int precision;
+        size_t i;
+        for (i = 0; i < num; i++) {
+            turns[i] = test_turn(i, bit_width);
+        }
+        success = test_serialize_mode(expected, observed, turns, num, bit_width, SERDES_TURN_DEG_MODE_SHORTEST, 0);
+        for (precision = SERDES_TURN_DEG_MIN_PRECISION; success && precision <= TEST_MAX_PRECISION; precision++) {
+            success = test_serialize_mode(expected, observed, turns, num, bit_width, SERDES_TURN_DEG_MODE_P, precision) &&
+                test_serialize_mode(expected, observed, turns, num, bit_width, SERDES_TURN_DEG_MODE_PS, precision);
+        }
+    }
+    free(turns);
+    free(expected);
+    free(observed);
+    return success;
+}
+
+
+/** Make the degrees for a bit-width: the ties between 2 turns and their neighbors, the multiples of 360, and the large or negative degrees. */
+static void make_test_degs(double *const degs, const size_t num, const unsigned int bit_width)
+{
+    const double lsb = ldexp(360.0, -(int)bit_width);
+    unsigned long seed = bit_width;
+    size_t i;
+    for (i = 0; i < num; i++) {
+        const double tie = (floor(ldexp((double)(seed % 65536), (int)bit_width - 16)) + 0.5) * lsb;
+        double r;
+        seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+        r = (double)seed / 0x7FFFFFFF - 0.5;
+        switch (i % 8) {
+        case 0:
+            degs[i] = r * 720.0;
+            break;
+        case 1:
+            degs[i] = r > 0 ? tie : -tie;
+            break;
+        case 2:
+            degs[i] = nextafter(tie, 1e300);
+            break;
+        case 3:
+            degs[i] = nextafter(-tie, -1e300);
+            break;
+        case 4:
+            degs[i] = 360.0 * (double)(long)(r * 2000.0);
+            break;
+        case 5:
+            degs[i] = nextafter(360.0 * (double)(long)(r * 2000.0), r > 0 ? 1e300 : -1e300);
+            break;
+        case 6:
+            /* around 2**52 where the SIMD code falls back to conv_deg_to_turn() */
+            degs[i] = r * 1.8e16;
+            break;
+        default:
+            degs[i] = r * 1e6 + tie;
+            break;
+        }
+    }
+}
+
+/** Compare conv_degs_to_turns() by AVX-512 or AVX2 with conv_deg_to_turn() for every bit-width. */
+static int test_conv_degs_to_turns(void)
+{
+    double degs[TEST_NUM_OF_DEGS];
+    unsigned int turns[TEST_NUM_OF_DEGS];
+    unsigned int bit_width;
+    for (bit_width = SERDES_TURN_DEG_MIN_BIT_WIDTH; bit_width <= TEST_MAX_BIT_WIDTH; bit_width++) {
+        size_t num;
+        make_test_degs(degs, NUM_OF(degs), bit_width);
+        for (num = 1; num <= NUM_OF(degs); num = num < TEST_MAX_TAIL ? num + 1 : NUM_OF(degs)) {
+            size_t i;
+            memset(turns, 0xFF, sizeof(turns));
+            conv_degs_to_turns(degs, num, bit_width, turns);
+            for (i = 0; i < NUM_OF(degs); i++) {
+                const unsigned int expected = i < num ? conv_deg_to_turn(degs[i], bit_width) : ~0u;
+                if (turns[i] != expected) {
+                    ERROR("Observed turn is mismatched: degree: %.17g, bit_width: %u, number of degrees: %u, index: %u, expected turn: %u, observed turn: %u",
+                          degs[i], bit_width, (unsigned int)num, (unsigned int)i, expected, turns[i]);
+                    return 0;
+                }
+            }
+            if (num == NUM_OF(degs)) {
+                break;
+            }
+        }
+    }
+    return 1;
+}
+
+
+int main(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+#if defined(__AVX512F__)
+    if (!__builtin_cpu_supports("avx512f")) {
+        fputs("Skipped: the processor doesn't support AVX-512F.\n", stdout);
+        return EXIT_SKIP;
+    }
+#endif
+    if (!__builtin_cpu_supports("avx2")) {
+        fputs("Skipped: the processor doesn't support AVX2.\n", stdout);
+        return EXIT_SKIP;
+    }
+#endif
+
+    fputs("Testing: SIMD: conv_degs_to_turns() is the same as conv_deg_to_turn()\n", stdout);
+    if (!test_conv_degs_to_turns()) {
+        return 1;
+    }
+    fputs("Testing: SIMD: serialize_turns_to_deg*() is the same as serialize_turn_to_deg*()\n", stdout);
+    if (!test_serialize_turns_to_deg()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,558 @@
+/* Converter between binary files of angles @ turn and text files of degrees.
+
+  Copyright © 2023 OOTA, Masato
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  Usage: serdes_turn_conv [-d] -w BIT_WIDTH [-t TYPE] [-m shortest|p|ps] [-p PRECISION] [-s newline|comma] [-j THREADS] [-o OUTPUT] INPUT
+
+  By default, it serializes the angles in a binary file to a text file. With -d, it deserializes a text file to a binary file.
+  - TYPE is the type of an angle in the binary file: u8, u16le, u16be, u32le, or u32be (default: u16le).
+  - The text file has a degree and a separator for each angle. When it's deserialized, white spaces around a degree are allowed, and the separator at the end may be omitted.
+
+  It maps the input file to the memory, and converts the chunks of it in parallel. The output is written in order.
+*/
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "serdes_turn_deg.h"
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the library accepts in this build. */
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the library accepts in this build. */
+#define MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length for MAX_BIT_WIDTH and MAX_PRECISION. */
+#define BUF_SIZE SERDES_TURN_DEG_WIDE_BUF_SIZE
+#else
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define BUF_SIZE SERDES_TURN_DEG_BUF_SIZE
+#endif
+
+/** The number of the angles in a chunk to serialize. */
+#define CHUNK_TURNS (1u << 18)
+
+/** The approximate length of a chunk to deserialize. */
+#define CHUNK_BYTES (1u << 22)
+
+/** The number of the angles that a worker converts at once. */
+#define BLOCK_TURNS 4096
+
+#define ERROR_MESSAGE_SIZE 256
+
+
+enum Mode {
+    MODE_SHORTEST,
+    MODE_P,
+    MODE_PS
+};
+
+/** An output buffer of a chunk. */
+struct Slot {
+    char *buf;
+    size_t capacity;
+    size_t len;
+    int ready;
+};
+
+struct Converter {
+    /* options */
+    int deserialize;
+    unsigned int bit_width;
+    enum Mode mode;
+    int precision;
+    char separator;
+    /** The bytes of an angle in the binary file. */
+    unsigned int turn_size;
+    int big_endian;
+
+    const unsigned char *input;
+    size_t input_size;
+    /** chunk_bounds[i] is the offset of the i-th chunk in input, and chunk_bounds[num_of_chunks] is input_size. */
+    size_t *chunk_bounds;
+    size_t num_of_chunks;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    struct Slot *slots;
+    size_t num_of_slots;
+    /** The next chunk to convert. */
+    size_t next_chunk;
+    /** The number of the chunks written. */
+    size_t written_chunks;
+    int failed;
+    char error[ERROR_MESSAGE_SIZE];
+};
+
+
+static unsigned int load_turn(const unsigned char *p, const unsigned int size, const int big_endian)
+{
+    unsigned int turn = 0;
+    unsigned int i;
+    for (i = 0; i < size; i++) {
+        turn |= (unsigned int)p[big_endian ? i : size - 1 - i] << (8 * (size - 1 - i));
+    }
+    return turn;
+}
+
+static void store_turn(unsigned char *p, const unsigned int turn, const unsigned int size, const int big_endian)
+{
+    unsigned int i;
+    for (i = 0; i < size; i++) {
+        p[big_endian ? i : size - 1 - i] = (unsigned char)(turn >> (8 * (size - 1 - i)));
+    }
+}
+
+static int reserve_slot(struct Slot *slot, const size_t capacity)
+{
+    if (slot->capacity < capacity) {
+        char *buf = realloc(slot->buf, capacity);
+        if (buf == NULL) {
+            return 0;
+        }
+        slot->buf = buf;
+        slot->capacity = capacity;
+    }
+    return 1;
+}
+
+
+/** Serialize a chunk of the binary file.
+    \return 0 if an error occurs, and error has the message.
+*/
+static int serialize_chunk(const struct Converter *conv, const size_t chunk, struct Slot *slot, char *error)
+{
+    const size_t begin = conv->chunk_bounds[chunk];
+    const size_t num = (conv->chunk_bounds[chunk + 1] - begin) / conv->turn_size;
+    const unsigned int max_turn = 0xFFFFFFFFu >> (32 - conv->bit_width);
+    unsigned int turns[BLOCK_TURNS];
+    char *p;
+    size_t i;
+
+    if (!reserve_slot(slot, num * BUF_SIZE + 1)) {
+        strcpy(error, "Out of memory");
+        return 0;
+    }
+    p = slot->buf;
+    for (i = 0; i < num; i += BLOCK_TURNS) {
+        const size_t n = num - i < BLOCK_TURNS ? num - i : BLOCK_TURNS;
+        size_t j;
+        for (j = 0; j < n; j++) {
+            turns[j] = load_turn(conv->input + begin + (i + j) * conv->turn_size, conv->turn_size, conv->big_endian);
+            if (turns[j] > max_turn) {
+                sprintf(error, "The angle #%lu (%u) is out of range of the bit-width",
+                        (unsigned long)((begin / conv->turn_size) + i + j), turns[j]);
+                return 0;
+            }
+        }
+        switch (conv->mode) {
+        case MODE_SHORTEST:
+            p = serialize_turns_to_deg(p, turns, n, conv->bit_width, conv->separator);
+            break;
+        case MODE_P:
+            p = serialize_turns_to_deg_p(p, turns, n, conv->bit_width, conv->precision, conv->separator);
+            break;
+        default:
+            p = serialize_turns_to_deg_ps(p, turns, n, conv->bit_width, conv->precision, conv->separator);
+            break;
+        }
+        *p++ = conv->separator;
+    }
+    if (chunk + 1 == conv->num_of_chunks && p != slot->buf) {
+        /* A text file ends with a newline. */
+        p[-1] = '\n';
+    }
+    slot->len = p - slot->buf;
+    return 1;
+}
+
+static int is_blank(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f' || c == '\n';
+}
+
+/** Deserialize a chunk of the text file.
+    \return 0 if an error occurs, and error has the message.
+*/
+static int deserialize_chunk(const struct Converter *conv, const size_t chunk, struct Slot *slot, char *error)
+{
+    const char *const text = (const char *)conv->input;
+    const char *ptr = text + conv->chunk_bounds[chunk];
+    const char *const end = text + conv->chunk_bounds[chunk + 1];
+    unsigned int turns[BLOCK_TURNS];
+    const char *endptrs[BLOCK_TURNS];
+    size_t len = 0;
+
+    /* Each angle has a digit and a separator at least except the last one. */
+    if (!reserve_slot(slot, ((end - ptr) / 2 + 1) * conv->turn_size)) {
+        strcpy(error, "Out of memory");
+        return 0;
+    }
+    while (ptr != end) {
+        const char *next;
+        const size_t n = deserialize_turns_from_deg(ptr, end - ptr, conv->separator, conv->bit_width, turns, BLOCK_TURNS, endptrs, &next);
+        size_t i;
+        for (i = 0; i < n; i++) {
+            /* Check the field [ptr, the separator) in the same way as deserialize_turn_from_deg_n(). */
+            const char *last = endptrs[i];
+            if (last != ptr && last[-1] == '.') {
+                last--;
+            }
+            if (last == ptr || !(last[-1] >= '0' && last[-1] <= '9')) {
+                sprintf(error, "No digits at offset %lu", (unsigned long)(ptr - text));
+                return 0;
+            }
+            for (ptr = endptrs[i]; ptr != end && *ptr != conv->separator && is_blank(*ptr); ptr++) {
+            }
+            if (ptr != end && *ptr != conv->separator) {
+                sprintf(error, "Invalid character at offset %lu", (unsigned long)(ptr - text));
+                return 0;
+            }
+            if (ptr != end) {
+                /* skip the separator */
+                ptr++;
+            }
+            store_turn((unsigned char *)slot->buf + len, turns[i], conv->turn_size, conv->big_endian);
+            len += conv->turn_size;
+        }
+        ptr = next;
+    }
+    slot->len = len;
+    return 1;
+}
+
+
+static void *worker(void *arg)
+{
+    struct Converter *conv = arg;
+    char error[ERROR_MESSAGE_SIZE];
+
+    pthread_mutex_lock(&conv->mutex);
+    for (;;) {
+        size_t chunk;
+        struct Slot *slot;
+        int success;
+        /* Wait until the slot of the next chunk is written. */
+        while (!conv->failed && conv->next_chunk < conv->num_of_chunks &&
+               conv->next_chunk >= conv->written_chunks + conv->num_of_slots) {
+            pthread_cond_wait(&conv->cond, &conv->mutex);
+        }
+        if (conv->failed || conv->next_chunk >= conv->num_of_chunks) {
+            break;
+        }
+        chunk = conv->next_chunk++;
+        slot = &conv->slots[chunk % conv->num_of_slots];
+        pthread_mutex_unlock(&conv->mutex);
+
+        if (conv->deserialize) {
+            success = deserialize_chunk(conv, chunk, slot, error);
+        } else {
+            success = serialize_chunk(conv, chunk, slot, error);
+        }
+
+        pthread_mutex_lock(&conv->mutex);
+        if (!success && !conv->failed) {
+            conv->failed = 1;
+            strcpy(conv->error, error);
+        }
+        slot->ready = 1;
+        pthread_cond_broadcast(&conv->cond);
+    }
+    pthread_mutex_unlock(&conv->mutex);
+    return NULL;
+}
+
+static int write_all(const int fd, const char *buf, size_t len)
+{
+    while (len > 0) {
+        const ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 1;
+}
+
+/** Write the chunks in order while the workers convert them.
+    \return 0 if an error occurs.
+*/
+static int write_chunks(struct Converter *conv, const int fd)
+{
+    size_t chunk;
+    int success = 1;
+    for (chunk = 0; success && chunk < conv->num_of_chunks; chunk++) {
+        struct Slot *const slot = &conv->slots[chunk % conv->num_of_slots];
+        pthread_mutex_lock(&conv->mutex);
+        while (!slot->ready && !conv->failed) {
+            pthread_cond_wait(&conv->cond, &conv->mutex);
+        }
+        success = !conv->failed;
+        pthread_mutex_unlock(&conv->mutex);
+        if (success && !write_all(fd, slot->buf, slot->len)) {
+            perror("write");
+            success = 0;
+        }
+        pthread_mutex_lock(&conv->mutex);
+        if (!success) {
+            conv->failed = 1;
+        }
+        slot->ready = 0;
+        conv->written_chunks++;
+        pthread_cond_broadcast(&conv->cond);
+        pthread_mutex_unlock(&conv->mutex);
+    }
+    return success;
+}
+
+
+/** Split the input into the chunks.
+    \return 0 if it's out of memory.
+*/
+static int split_chunks(struct Converter *conv)
+{
+    const size_t chunk_size = conv->deserialize ? CHUNK_BYTES : (size_t)CHUNK_TURNS * conv->turn_size;
+    /* The last incomplete angle in the binary file is ignored. */
+    const size_t size = conv->deserialize ? conv->input_size : conv->input_size - conv->input_size % conv->turn_size;
+    size_t n = 0;
+    size_t offset = 0;
+
+    conv->chunk_bounds = malloc((size / chunk_size + 2) * sizeof(conv->chunk_bounds[0]));
+    if (conv->chunk_bounds == NULL) {
+        return 0;
+    }
+    while (offset < size) {
+        conv->chunk_bounds[n++] = offset;
+        if (size - offset <= chunk_size) {
+            offset = size;
+        } else if (conv->deserialize) {
+            /* The chunk ends after a separator. */
+            const unsigned char *const sep = memchr(conv->input + offset + chunk_size, conv->separator, size - offset - chunk_size);
+            offset = sep != NULL ? (size_t)(sep - conv->input) + 1 : size;
+        } else {
+            offset += chunk_size;
+        }
+    }
+    conv->chunk_bounds[n] = size;
+    conv->num_of_chunks = n;
+    return 1;
+}
+
+
+static void usage(void)
+{
+    fputs("Usage: serdes_turn_conv [-d] -w BIT_WIDTH [-t u8|u16le|u16be|u32le|u32be] [-m shortest|p|ps] [-p PRECISION] [-s newline|comma] [-j THREADS] [-o OUTPUT] INPUT\n", stderr);
+}
+
+int main(int argc, char *argv[])
+{
+    struct Converter conv;
+    const char *input_path = NULL;
+    const char *output_path = NULL;
+    long num_of_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t *threads = NULL;
+    long num_of_started = 0;
+    struct stat st;
+    void *map = MAP_FAILED;
+    int input_fd = -1;
+    int output_fd = STDOUT_FILENO;
+    int success = 0;
+    size_t i;
+    int arg;
+
+    memset(&conv, 0, sizeof(conv));
+    conv.mode = MODE_SHORTEST;
+    conv.separator = '\n';
+    conv.turn_size = 2;
+    for (arg = 1; arg < argc; arg++) {
+        const char *const opt = argv[arg];
+        const char *const value = arg + 1 < argc ? argv[arg + 1] : NULL;
+        if (strcmp(opt, "-d") == 0) {
+            conv.deserialize = 1;
+            continue;
+        }
+        if (opt[0] != '-') {
+            if (input_path != NULL) {
+                usage();
+                return 1;
+            }
+            input_path = opt;
+            continue;
+        }
+        if (value == NULL) {
+            usage();
+            return 1;
+        }
+        arg++;
+        if (strcmp(opt, "-w") == 0) {
+            char *end;
+            conv.bit_width = (unsigned int)strtoul(value, &end, 10);
+            if (*end != '\0' || end == value) {
+                fprintf(stderr, "Invalid bit-width: %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(opt, "-t") == 0) {
+            if (strcmp(value, "u8") == 0) {
+                conv.turn_size = 1;
+            } else if (strcmp(value, "u16le") == 0 || strcmp(value, "u16be") == 0) {
+                conv.turn_size = 2;
+            } else if (strcmp(value, "u32le") == 0 || strcmp(value, "u32be") == 0) {
+                conv.turn_size = 4;
+            } else {
+                fprintf(stderr, "Invalid type: %s\n", value);
+                return 1;
+            }
+            conv.big_endian = strcmp(value + strlen(value) - 2, "be") == 0;
+        } else if (strcmp(opt, "-m") == 0) {
+            if (strcmp(value, "shortest") == 0) {
+                conv.mode = MODE_SHORTEST;
+            } else if (strcmp(value, "p") == 0) {
+                conv.mode = MODE_P;
+            } else if (strcmp(value, "ps") == 0) {
+                conv.mode = MODE_PS;
+            } else {
+                fprintf(stderr, "Invalid mode: %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(opt, "-p") == 0) {
+            char *end;
+            const long precision = strtol(value, &end, 10);
+            if (*end != '\0' || end == value || precision < SERDES_TURN_DEG_MIN_PRECISION || precision > MAX_PRECISION) {
+                fprintf(stderr, "Invalid precision: %s\n", value);
+                return 1;
+            }
+            conv.precision = (int)precision;
+        } else if (strcmp(opt, "-s") == 0) {
+            if (strcmp(value, "newline") == 0) {
+                conv.separator = '\n';
+            } else if (strcmp(value, "comma") == 0) {
+                conv.separator = ',';
+            } else {
+                fprintf(stderr, "Invalid separator: %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(opt, "-j") == 0) {
+            char *end;
+            num_of_threads = strtol(value, &end, 10);
+            if (*end != '\0' || end == value || num_of_threads <= 0) {
+                fprintf(stderr, "Invalid number of threads: %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(opt, "-o") == 0) {
+            output_path = value;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (input_path == NULL || conv.bit_width == 0) {
+        usage();
+        return 1;
+    }
+    if (conv.bit_width < SERDES_TURN_DEG_MIN_BIT_WIDTH || conv.bit_width > MAX_BIT_WIDTH ||
+        conv.bit_width > conv.turn_size * 8) {
+        fprintf(stderr, "Invalid bit-width for the type: %u\n", conv.bit_width);
+        return 1;
+    }
+    if (num_of_threads <= 0) {
+        num_of_threads = 1;
+    }
+
+    input_fd = open(input_path, O_RDONLY);
+    if (input_fd < 0 || fstat(input_fd, &st) != 0) {
+        perror(input_path);
+        goto cleanup;
+    }
+    conv.input_size = (size_t)st.st_size;
+    if (conv.input_size > 0) {
+        map = mmap(NULL, conv.input_size, PROT_READ, MAP_PRIVATE, input_fd, 0);
+        if (map == MAP_FAILED) {
+            perror(input_path);
+            goto cleanup;
+        }
+        posix_madvise(map, conv.input_size, POSIX_MADV_SEQUENTIAL);
+        conv.input = map;
+    }
+    if (output_path != NULL) {
+        output_fd = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (output_fd < 0) {
+            perror(output_path);
+            goto cleanup;
+        }
+    }
+
+    /* Two chunks for each thread to keep the threads busy while writing. */
+    conv.num_of_slots = (size_t)num_of_threads * 2;
+    conv.slots = calloc(conv.num_of_slots, sizeof(conv.slots[0]));
+    threads = malloc((size_t)num_of_threads * sizeof(threads[0]));
+    if (conv.slots == NULL || threads == NULL || !split_chunks(&conv)) {
+        fputs("Out of memory\n", stderr);
+        goto cleanup;
+    }
+    pthread_mutex_init(&conv.mutex, NULL);
+    pthread_cond_init(&conv.cond, NULL);
+    for (; num_of_started < num_of_threads; num_of_started++) {
+        if (pthread_create(&threads[num_of_started], NULL, worker, &conv) != 0) {
+            break;
+        }
+    }
+    if (num_of_started == 0) {
+        fputs("Failed to create a thread\n", stderr);
+    } else {
+        success = write_chunks(&conv, output_fd);
+        if (!success && conv.error[0] != '\0') {
+            fprintf(stderr, "%s: %s\n", input_path, conv.error);
+        }
+    }
+    while (num_of_started > 0) {
+        pthread_join(threads[--num_of_started], NULL);
+    }
+    pthread_cond_destroy(&conv.cond);
+    pthread_mutex_destroy(&conv.mutex);
+
+cleanup:
+    if (output_fd >= 0 && output_fd != STDOUT_FILENO && close(output_fd) != 0) {
+        perror(output_path);
+        success = 0;
+    }
+    if (map != MAP_FAILED) {
+        munmap(map, conv.input_size);
+    }
+    if (input_fd >= 0) {
+        close(input_fd);
+    }
+    if (conv.slots != NULL) {
+        for (i = 0; i < conv.num_of_slots; i++) {
+            free(conv.slots[i].buf);
+        }
+    }
+    free(conv.slots);
+    free(conv.chunk_bounds);
+    free(threads);
+    return success ? 0 : 1;
+}
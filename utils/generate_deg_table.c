@@ -0,0 +1,218 @@
+/* Generator of the tables of the serialized strings for serdes_turn_deg.
+
+  Copyright © 2023 OOTA, Masato
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  Usage: generate_deg_table -o OUTPUT -w BIT_WIDTH[,BIT_WIDTH...] [-p PRECISION[,PRECISION...]]
+
+  This program must be linked with serdes_turn_deg.c built without SERDES_TURN_DEG_USE_TABLE.
+  It writes a header file that defines deg_tables[] and NUM_OF_DEG_TABLES for serdes_turn_deg.c.
+  The tables contain the strings of serialize_turn_to_deg() for each bit-width, and the strings of serialize_turn_to_deg_p() and serialize_turn_to_deg_ps() for each pair of bit-width and precision.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "serdes_turn_deg.h"
+
+#ifdef SERDES_TURN_DEG_WIDE
+/** The maximum bit-width that the library accepts in this build. */
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_WIDE_MAX_BIT_WIDTH
+/** The maximum precision that the library accepts in this build. */
+#define MAX_PRECISION SERDES_TURN_DEG_WIDE_MAX_PRECISION
+/** The buffer length for MAX_BIT_WIDTH and MAX_PRECISION. */
+#define BUF_SIZE SERDES_TURN_DEG_WIDE_BUF_SIZE
+#else
+#define MAX_BIT_WIDTH SERDES_TURN_DEG_MAX_BIT_WIDTH
+#define MAX_PRECISION SERDES_TURN_DEG_MAX_PRECISION
+#define BUF_SIZE SERDES_TURN_DEG_BUF_SIZE
+#endif
+
+/** The maximum bit-width to generate a table. The table size is about 10 * 2**bit_width bytes. */
+#define MAX_TABLE_BIT_WIDTH 16
+
+/* These must be the same as SERIALIZE_KIND_* in serdes_turn_deg.c. */
+#define SERIALIZE_KIND_SHORTEST 0
+#define SERIALIZE_KIND_P 1
+#define SERIALIZE_KIND_PS 2
+
+#define MAX_LIST_SIZE 32
+
+
+/** Parse a comma separated list of integers.
+    \return The number of integers, or -1 if the list is invalid.
+*/
+static int parse_list(const char *arg, int *list, const int min_value, const int max_value)
+{
+    int n = 0;
+    while (*arg != '\0') {
+        char *end;
+        const long value = strtol(arg, &end, 10);
+        if (end == arg || value < min_value || value > max_value || n >= MAX_LIST_SIZE) {
+            return -1;
+        }
+        list[n++] = (int)value;
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return -1;
+        }
+        arg = end;
+    }
+    return n;
+}
+
+
+/** Serialize an angle in the specified kind. */
+static char *serialize(char *buf, const unsigned int turn, const unsigned int bit_width, const int kind, const int precision)
+{
+    switch (kind) {
+    case SERIALIZE_KIND_SHORTEST:
+        return serialize_turn_to_deg(buf, turn, bit_width);
+    case SERIALIZE_KIND_P:
+        return serialize_turn_to_deg_p(buf, turn, bit_width, precision);
+    default:
+        return serialize_turn_to_deg_ps(buf, turn, bit_width, precision);
+    }
+}
+
+
+/** Make the suffix of the table name, such as "12_ps_m1" for bit_width = 12, kind = SERIALIZE_KIND_PS, and precision = -1. */
+static void make_table_name(char *name, const unsigned int bit_width, const int kind, const int precision)
+{
+    const char *const kind_name[] = { "s", "p", "ps" };
+    if (kind == SERIALIZE_KIND_SHORTEST) {
+        sprintf(name, "%u_%s", bit_width, kind_name[kind]);
+    } else {
+        sprintf(name, "%u_%s_%c%d", bit_width, kind_name[kind], precision < 0 ? 'm' : 'p', abs(precision));
+    }
+}
+
+
+/** Write a table. */
+static void write_table(FILE *fp, const unsigned int bit_width, const int kind, const int precision)
+{
+    char buf[BUF_SIZE];
+    char name[32];
+    const unsigned int num = 1u << bit_width;
+    unsigned int turn;
+    unsigned long offset = 0;
+
+    make_table_name(name, bit_width, kind, precision);
+
+    /* Not a string literal, because C89 doesn't require to support a long string literal. */
+    fprintf(fp, "static const char deg_table_text_%s[] = {", name);
+    for (turn = 0; turn < num; turn++) {
+        const char *p;
+        serialize(buf, turn, bit_width, kind, precision);
+        if (turn % 8 == 0) {
+            fputs("\n   ", fp);
+        }
+        for (p = buf; *p != '\0'; p++) {
+            fprintf(fp, " '%c',", *p);
+        }
+    }
+    fputs("\n};\n", fp);
+
+    fprintf(fp, "static const unsigned int deg_table_offsets_%s[] = {", name);
+    for (turn = 0; turn <= num; turn++) {
+        if (turn % 8 == 0) {
+            fputs("\n   ", fp);
+        }
+        fprintf(fp, " %lu,", offset);
+        if (turn < num) {
+            offset += serialize(buf, turn, bit_width, kind, precision) - buf;
+        }
+    }
+    fputs("\n};\n\n", fp);
+}
+
+
+/** Write the entry of deg_tables[]. */
+static void write_table_entry(FILE *fp, const unsigned int bit_width, const int kind, const int precision)
+{
+    const char *const kind_macro[] = { "SERIALIZE_KIND_SHORTEST", "SERIALIZE_KIND_P", "SERIALIZE_KIND_PS" };
+    const int place = kind == SERIALIZE_KIND_SHORTEST ? -SERDES_TURN_DEG_MIN_PRECISION : -precision;
+    char name[32];
+    make_table_name(name, bit_width, kind, precision);
+    fprintf(fp, "    { %u, %s, %d, deg_table_offsets_%s, deg_table_text_%s },\n",
+            bit_width, kind_macro[kind], place, name, name);
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char *output = NULL;
+    int bit_widths[MAX_LIST_SIZE];
+    int precisions[MAX_LIST_SIZE];
+    int num_of_bit_widths = 0;
+    int num_of_precisions = 0;
+    int i;
+    int j;
+    FILE *fp;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            num_of_bit_widths = parse_list(argv[++i], bit_widths, SERDES_TURN_DEG_MIN_BIT_WIDTH, MAX_TABLE_BIT_WIDTH);
+            if (num_of_bit_widths < 0) {
+                fprintf(stderr, "Invalid bit-width list: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            num_of_precisions = parse_list(argv[++i], precisions, SERDES_TURN_DEG_MIN_PRECISION, MAX_PRECISION);
+            if (num_of_precisions < 0) {
+                fprintf(stderr, "Invalid precision list: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            fputs("Usage: generate_deg_table -o OUTPUT -w BIT_WIDTH[,BIT_WIDTH...] [-p PRECISION[,PRECISION...]]\n", stderr);
+            return 1;
+        }
+    }
+    if (output == NULL || num_of_bit_widths == 0) {
+        fputs("Usage: generate_deg_table -o OUTPUT -w BIT_WIDTH[,BIT_WIDTH...] [-p PRECISION[,PRECISION...]]\n", stderr);
+        return 1;
+    }
+
+    fp = fopen(output, "w");
+    if (fp == NULL) {
+        perror(output);
+        return 1;
+    }
+    fputs("/* This file is generated by generate_deg_table. Don't edit. */\n\n", fp);
+    for (i = 0; i < num_of_bit_widths; i++) {
+        write_table(fp, bit_widths[i], SERIALIZE_KIND_SHORTEST, 0);
+        for (j = 0; j < num_of_precisions; j++) {
+            write_table(fp, bit_widths[i], SERIALIZE_KIND_P, precisions[j]);
+            write_table(fp, bit_widths[i], SERIALIZE_KIND_PS, precisions[j]);
+        }
+    }
+    fputs("static const struct DegTable deg_tables[] = {\n", fp);
+    for (i = 0; i < num_of_bit_widths; i++) {
+        write_table_entry(fp, bit_widths[i], SERIALIZE_KIND_SHORTEST, 0);
+        for (j = 0; j < num_of_precisions; j++) {
+            write_table_entry(fp, bit_widths[i], SERIALIZE_KIND_P, precisions[j]);
+            write_table_entry(fp, bit_widths[i], SERIALIZE_KIND_PS, precisions[j]);
+        }
+    }
+    fputs("};\n\n#define NUM_OF_DEG_TABLES (sizeof(deg_tables) / sizeof(deg_tables[0]))\n", fp);
+    if (ferror(fp) || fclose(fp) != 0) {
+        perror(output);
+        return 1;
+    }
+    return 0;
+}